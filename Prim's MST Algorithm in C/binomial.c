@@ -4,381 +4,497 @@
  *  to display, compare, update, and free the generic value stored in the tree.
  *
  *  Update function would be passed in for graph algorithims, otherwise use NULL.
+ *
+ *  A heap that is filled all at once should be given its values with
+ *  buildBINOMIAL, which links them in O(n). In lazy mode insert only adds
+ *  the new node to the root list and consolidation waits for the next
+ *  extract.
+ *
+ *  The root list and the children of every node are circular doubly
+ *  linked rings threaded through the nodes themselves, and the callbacks
+ *  are kept once on the heap. Nodes are carved out of slabs owned by the
+ *  heap and go back on a free list when their value is extracted, so a
+ *  value costs no allocation of its own.
+ *
+ *  The heap counts its operations, comparisons, the levels values climb
+ *  in bubbleUp and the longest root list it has had, and with timing on
+ *  it also adds up the time spent in each kind of operation.
+ *  statisticsBINOMIAL reports them.
+ *
+ *  decreaseKeyBINOMIALbatch decreases many values at once, such as every
+ *  neighbor prim improves from one vertex. The values are all set first
+ *  and then bubbled up the shallowest first: a value only ever swaps with
+ *  its ancestors, so the values still to be bubbled stay where their
+ *  nodes say, and the extreme pointer is looked at once at the end.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <assert.h>
-#include <math.h>
+#include <time.h>
 #include "binomial.h"
-#include "dll.h"
 #include "queue.h"
 
+// the degree of a node is below log2 of the size, which is an int
+#define MAXDEGREE 64
+#define SLABMINIMUM 64
+#define SLABMAXIMUM 65536
+
+// what the time is added up for, consolidate is also inside the others
+enum {TIMEINSERT,TIMEEXTRACT,TIMEDECREASE,TIMECONSOLIDATE,TIMERS};
+static const char * timerNames[TIMERS] = {"insert","extract","decreaseKey","consolidate"};
+
 typedef struct binomialnode{
     void * data;
     int degree;
-    DLL * children; //DLL that holds the pointers to the child nodes
-    struct binomialnode * parent;
-    void * owner; // holds a pointer to its DLL node, useful for removing
-    void (*display)(void *,FILE *);
-    void (*free)(void *);
+    struct binomialnode * parent;   // 0 for a root
+    struct binomialnode * child;    // first child, the children form a ring
+    struct binomialnode * left;     // siblings, or roots, form a ring
+    struct binomialnode * right;
 }BinomialNODE;
 
+typedef struct binomialslab{
+    struct binomialslab * next;
+    int used;
+    int capacity;
+    BinomialNODE nodes[];
+}BinomialSLAB;
+
 struct binomial{
     void (*display)(void *,FILE *);
     int (*compare)(void *,void *);
     void (*update)(void *,void *);
     void (*free)(void *);
     BinomialNODE * extreme;
-    DLL * rootList;
+    BinomialNODE * rootList;    // first root
+    int roots;
     int size;
+    int lazy;   // insert leaves consolidation to the next extract
+    BinomialSLAB * slabs;       // the newest slab first
+    BinomialNODE * released;    // nodes given back, chained through right
+    BinomialNODE ** batch;      // decreaseKeyBINOMIALbatch's nodes by depth
+    int * depths;
+    int batchCapacity;
+    // statistics
+    long long inserts;
+    long long extracts;
+    long long decreaseKeys;
+    long long consolidates;
+    long long comparisons;
+    long long levels;           // climbed by bubbleUp
+    int maxRoots;
+    int timing;
+    int64_t nanoseconds[TIMERS];
 };
 
-////////////ARRAY used only for consilidation purposes ////////////////
-
-typedef struct array{
-    void ** array;
-    int size;
-    void (*display)(void *,FILE *);
-    void (*free)(void *);
-    
-}ARRAY;
-static ARRAY *newARRAY(void (*d)(void *,FILE *),
-                       void (*f)(void *),int x){
-    ARRAY * created = malloc(sizeof(ARRAY));
-    created->array = malloc(sizeof(void*) * x);
-    for (int i = 0; i < x; i++){
-        created->array[i] = 0;
-    }
-    created->size = x;
-    created->display = d;
-    created->free = f;
-    return created;
-}
-static int getSize(ARRAY * a){
-    assert(a != 0);
-    return a->size;
-}
-static int validIndex(ARRAY * a, int i){
-    assert(a != 0);
-    if (i >= 0 && i < getSize(a)){
-        return 1;
-    }
-    return 0;
-}
-static void setARRAY(ARRAY *a,int index, void *value){
-    assert(validIndex(a,index) != 0);
-    a->array[index] = value;
-}
-static void *getARRAY(ARRAY *a,int index){
-    assert(validIndex(a,index) != 0);
-    return a->array[index];
-}
-static int isNull (ARRAY * a, int index){
-    if (getARRAY(a,index) == 0) return 1;
-    return 0;
-}
-static void freeARRAY(ARRAY *a){
-    int s = getSize(a);
-    for (int i = 0; i < s; i++){
-        if (a->free != 0 && a->array[i] != 0){
-            a->free(a->array[i]);
-        }
-    }
-    free(a->array);
-    free((ARRAY *) a);
-}
-///////////////// END of ARRAY Functions ////////////////
-
-
-
-/// FUNCITONS TO BE PASSED IN///
-
-void swapperBinomialNODE(void *a,void *b){
-    BinomialNODE * nodeA = (BinomialNODE *)a;
-    BinomialNODE * nodeB = (BinomialNODE *)b;
-    void * temp = nodeA->data;
-    nodeA->data = nodeB->data;
-    nodeB->data = temp;
-}//swapper
-
-void displayBINOMIALnode(void * value,FILE * fp){
-    BinomialNODE * x = (BinomialNODE *)value;
-    void * generic = x->data;
-    x->display(generic,fp);
-}//display
-void displayBINOMIALnodeDEBUG(void * value,FILE * fp){
-    BinomialNODE * x = (BinomialNODE *)value;
-    void * generic = x->data;
-    x->display(generic,fp);
-    fprintf(fp,"[");
-    fprintf(fp,"%d",x->degree);
-    fprintf(fp,"]");
-    generic = x->parent->data;
-    fprintf(fp,"\tparent's val is<");
-    x->display(generic,fp);
-    fprintf(fp,"[");
-    fprintf(fp,"%d",x->parent->degree);
-    fprintf(fp,"]");
-    fprintf(fp,">");
-}//displayDebug
-void freeBINOMIALnode (void * value){
-    BinomialNODE * node = (BinomialNODE *)value;
-    void * generic = node->data;
-    if (generic != 0) node->free(generic);
-    free((BinomialNODE *)node);
-}//free
-
 //Constructor
 extern BINOMIAL *newBINOMIAL(void (*d)(void *,FILE *), int (*c)(void *,void *),void (*s)(void *,void *),void (*f)(void *)){
     BINOMIAL * createdBinomial = malloc(sizeof(BINOMIAL));
+    assert(createdBinomial != 0);
     createdBinomial->display = d;
     createdBinomial->compare = c;
     createdBinomial->free = f;
     createdBinomial->extreme = 0;
-    createdBinomial->rootList = newDLL(displayBINOMIALnode,freeBINOMIALnode);
+    createdBinomial->rootList = 0;
+    createdBinomial->roots = 0;
     createdBinomial->update = s;
     createdBinomial->size = 0;
+    createdBinomial->lazy = 0;
+    createdBinomial->slabs = 0;
+    createdBinomial->released = 0;
+    createdBinomial->batch = 0;
+    createdBinomial->depths = 0;
+    createdBinomial->batchCapacity = 0;
+    createdBinomial->inserts = 0;
+    createdBinomial->extracts = 0;
+    createdBinomial->decreaseKeys = 0;
+    createdBinomial->consolidates = 0;
+    createdBinomial->comparisons = 0;
+    createdBinomial->levels = 0;
+    createdBinomial->maxRoots = 0;
+    createdBinomial->timing = 0;
+    for (int i = 0; i < TIMERS; i++){
+        createdBinomial->nanoseconds[i] = 0;
+    }
     return createdBinomial;
 }
-/// Private BINOMIAL HEAP FUNCTIONS //////
-static DLL *getBINOMIALrootList(BINOMIAL * b){
-    assert(b != 0);
-    return b->rootList;
-}
-static void setBINOMIALsize(BINOMIAL * b, int s){
-    assert(b != 0);
-    b->size = s;
-}
-static int getBINOMIALsize(BINOMIAL * b){
-    assert(b != 0);
-    return b->size;
-}
-static void setBINOMIALextreme(BINOMIAL * b,BinomialNODE * x){
-    assert(b != 0);
-    b->extreme = x;
-}
-static BinomialNODE *getBINOMIALextreme(BINOMIAL * b){
-    assert(b != 0);
-    return b->extreme;
-}
 
-//// Private BinomialNODE FUNCTIONS ////////
-static void setBinomialNODEdata(BinomialNODE * n, void * value){
-    assert(n != 0);
-    n->data = value;
-}
-static void *getBinomialNODEdata(BinomialNODE * n){
-    assert(n != 0);
-    return n->data;
+//// Private statistics FUNCTIONS ////
+static int compareValues(BINOMIAL * b,void * x,void * y){
+    b->comparisons++;
+    return b->compare(x,y);
+}
+// reads the clock only when timing is on
+static int64_t startTimer(BINOMIAL * b){
+    if (!b->timing) return 0;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+static void stopTimer(BINOMIAL * b,int timer,int64_t start){
+    if (!b->timing) return;
+    b->nanoseconds[timer] += startTimer(b) - start;
 }
-static void setBinomialNODEdegree(BinomialNODE * n, int d){
-    assert(n != 0);
-    n->degree = d;
-}
-static int getBinomialNODEdegree(BinomialNODE * n){
-    assert(n != 0);
-    return n->degree;
-}
-static void setBinomialNODEparent(BinomialNODE * n, BinomialNODE * p){
-    assert(n != 0);
-    n->parent = p;
-}
-static BinomialNODE *getBinomialNODEparent(BinomialNODE * n){
-    assert(n != 0);
-    return n->parent;
-}
-static DLL *getBinomialNODEchildren(BinomialNODE * n){
-    assert(n != 0);
-    return n->children;
-}
-static void setBinomialNODEowner(BinomialNODE * n,void * o){
-    assert(n != 0);
-    n->owner = o;
-}
-static DLL *getBinomialNODEowner(BinomialNODE * n){
-    assert(n != 0);
-    return n->owner;
+
+//// Private slab FUNCTIONS ////
+// makes sure at least n more nodes can be handed out without a new slab
+static void reserveNODES(BINOMIAL * b,int n){
+    BinomialSLAB * slab = b->slabs;
+    if (slab != 0 && slab->capacity - slab->used >= n) return;
+    int capacity = (slab == 0) ? SLABMINIMUM : slab->capacity * 2;
+    if (capacity > SLABMAXIMUM) capacity = SLABMAXIMUM;
+    if (capacity < n) capacity = n;
+    slab = malloc(sizeof(BinomialSLAB) + sizeof(BinomialNODE) * capacity);
+    assert(slab != 0);
+    slab->next = b->slabs;
+    slab->used = 0;
+    slab->capacity = capacity;
+    b->slabs = slab;
 }
 static BinomialNODE *newBinomialNODE(BINOMIAL * b,void * value){
-    BinomialNODE * createdBinomialNODE = malloc(sizeof(BinomialNODE));
-    createdBinomialNODE->data = value;
-    createdBinomialNODE->degree = 0;
-    createdBinomialNODE->children = newDLL(displayBINOMIALnode,freeBINOMIALnode);
-    createdBinomialNODE->parent = createdBinomialNODE;
-    createdBinomialNODE->owner = 0;
-    createdBinomialNODE->display = b->display;
-    createdBinomialNODE->free = b->free;
-    return createdBinomialNODE;
+    BinomialNODE * n = b->released;
+    if (n != 0){
+        b->released = n->right;
+    }
+    else{
+        reserveNODES(b,1);
+        n = &b->slabs->nodes[b->slabs->used];
+        b->slabs->used++;
+    }
+    n->data = value;
+    n->degree = 0;
+    n->parent = 0;
+    n->child = 0;
+    n->left = n;
+    n->right = n;
+    return n;
+}
+static void releaseBinomialNODE(BINOMIAL * b,BinomialNODE * n){
+    n->data = 0;
+    n->right = b->released;
+    b->released = n;
 }
 
+//// Private ring FUNCTIONS ////
+// joins the ring holding y into the ring holding x, just after x
+static void spliceRing(BinomialNODE * x,BinomialNODE * y){
+    BinomialNODE * xRight = x->right;
+    BinomialNODE * yLeft = y->left;
+    x->right = y;
+    y->left = x;
+    yLeft->right = xRight;
+    xRight->left = yLeft;
+}
+static void removeFromRing(BinomialNODE * n){
+    n->left->right = n->right;
+    n->right->left = n->left;
+    n->left = n;
+    n->right = n;
+}
+// puts a ring of roots at the end of the root list
+static void appendRoots(BINOMIAL * b,BinomialNODE * ring,int count){
+    if (b->rootList == 0) b->rootList = ring;
+    else spliceRing(b->rootList->left,ring);
+    b->roots += count;
+    if (b->roots > b->maxRoots) b->maxRoots = b->roots;
+}
+static void removeRoot(BINOMIAL * b,BinomialNODE * n){
+    if (b->rootList == n) b->rootList = (n->right == n) ? 0 : n->right;
+    removeFromRing(n);
+    b->roots--;
+}
 
 ///// Private helper FUNCTIONS for insertBINOMIAL /////
 static BinomialNODE *combine(BINOMIAL * b,BinomialNODE * x,BinomialNODE * y){
     //if x's value is more extreme than y's
-    if (b->compare(getBinomialNODEdata(x),getBinomialNODEdata(y)) < 0){
-        setBinomialNODEowner(y,insertDLL(x->children,sizeDLL(x->children),y));
-        setBinomialNODEparent(y,x);
-        setBinomialNODEdegree(x,getBinomialNODEdegree(x) + 1);
-        return x;
+    if (compareValues(b,x->data,y->data) >= 0){
+        BinomialNODE * temp = x;
+        x = y;
+        y = temp;
     }
-    else{
-        setBinomialNODEowner(x,insertDLL(y->children,sizeDLL(y->children),x));
-        setBinomialNODEparent(x,y);
-        setBinomialNODEdegree(y,getBinomialNODEdegree(y) + 1);
-        return y;
-    }
-}
-
-static void updateConsolidationArray (BINOMIAL * b,ARRAY * D,BinomialNODE * spot){
-    int degree = getBinomialNODEdegree(spot);
-    while (!(isNull(D,degree))){
-        spot = combine(b,spot,getARRAY(D,degree));
-        setARRAY(D,degree,0);
+    // y becomes the last child of x
+    y->parent = x;
+    if (x->child == 0) x->child = y;
+    else spliceRing(x->child->left,y);
+    x->degree++;
+    return x;
+}
+static void updateConsolidationArray (BINOMIAL * b,BinomialNODE ** D,BinomialNODE * spot){
+    int degree = spot->degree;
+    while (D[degree] != 0){
+        spot = combine(b,spot,D[degree]);
+        D[degree] = 0;
         degree++;
     }
-    setARRAY(D,degree,spot);
+    D[degree] = spot;
 }
-static void consolidate(BINOMIAL * b){
-    int size = log(getBINOMIALsize(b))/log(2) + 1;
-    ARRAY * D = newARRAY(displayBINOMIALnode,0,size);
-    void * spot = 0;
-    while (sizeDLL(b->rootList) > 0){
-        firstDLL(b->rootList);
-        spot = currentDLL(b->rootList);
-        assert(getBinomialNODEowner(spot) != 0);
-        removeDLLnode(b->rootList,getBinomialNODEowner(spot));
+// empties b's root list into D, linking the roots of equal degree
+static void drainRootList(BINOMIAL * b,BinomialNODE ** D){
+    while (b->rootList != 0){
+        BinomialNODE * spot = b->rootList;
+        removeRoot(b,spot);
         updateConsolidationArray(b,D,spot);
     }
-    //transfer the D array back to the heap, keeping track of the extreme value
-    setBINOMIALextreme(b,0);
-    BinomialNODE * ptr = 0;
-    
-    for (int i = 0; i < size; i++){
-        if (!(isNull(D,i))){
-            ptr = getARRAY(D,i);
-            //insert D[i] into b's root list (via the linked-list's insert method)
-            setBinomialNODEowner(ptr,insertDLL(b->rootList,sizeDLL(getBINOMIALrootList(b)),ptr));
-            //update b's extreme pointer if it's null or b's comparator indicates that D[i] is more extreme
-            if (getBINOMIALextreme(b) == 0) setBINOMIALextreme(b,ptr);
-            else if (b->compare(getBinomialNODEdata(ptr),getBinomialNODEdata(getBINOMIALextreme(b))) < 0){
-                setBINOMIALextreme(b,ptr);
-            }
+}
+//transfer the D array back to the heap, keeping track of the extreme value
+static void fillRootList(BINOMIAL * b,BinomialNODE ** D){
+    b->extreme = 0;
+    for (int i = 0; i < MAXDEGREE; i++){
+        BinomialNODE * ptr = D[i];
+        if (ptr == 0) continue;
+        appendRoots(b,ptr,1);
+        //update b's extreme pointer if it's null or b's comparator indicates that D[i] is more extreme
+        if (b->extreme == 0 || compareValues(b,ptr->data,b->extreme->data) < 0){
+            b->extreme = ptr;
         }
     }
-    freeARRAY(D);
+}
+static void consolidate(BINOMIAL * b){
+    int64_t start = startTimer(b);
+    BinomialNODE * D[MAXDEGREE] = {0};
+    drainRootList(b,D);
+    fillRootList(b,D);
+    b->consolidates++;
+    stopTimer(b,TIMECONSOLIDATE,start);
+}
+static void displayBINOMIALnode(BINOMIAL * b,BinomialNODE * n,FILE * fp){
+    if (b->display != 0) b->display(n->data,fp);
 }
 
 
 ///// PUBLIC FUNCTIONS ////
 extern void *insertBINOMIAL(BINOMIAL *b,void *value){
+    int64_t start = startTimer(b);
     BinomialNODE * n = newBinomialNODE(b,value);
-    setBinomialNODEowner(n,insertDLL(b->rootList,0,n));
-    setBINOMIALsize(b,getBINOMIALsize(b) + 1);
-    consolidate(b);
+    // new nodes go to the front of the root list
+    appendRoots(b,n,1);
+    b->rootList = n;
+    b->size++;
+    if (b->lazy){
+        if (b->extreme == 0 || compareValues(b,value,b->extreme->data) < 0){
+            b->extreme = n;
+        }
+    }
+    else consolidate(b);
+    b->inserts++;
+    stopTimer(b,TIMEINSERT,start);
     return n;
 }
+// adds n values at once, linking them like a binary counter in O(n)
+// the update function, if any, is called with each value and its node
+extern void buildBINOMIAL(BINOMIAL *b,void **values,int n){
+    assert(b != 0 && n >= 0);
+    int64_t start = startTimer(b);
+    BinomialNODE * D[MAXDEGREE] = {0};
+    drainRootList(b,D);
+    if (b->released == 0) reserveNODES(b,n);
+    for (int i = 0; i < n; i++){
+        BinomialNODE * node = newBinomialNODE(b,values[i]);
+        if (b->update != 0) b->update(values[i],node);
+        updateConsolidationArray(b,D,node);
+    }
+    b->size += n;
+    fillRootList(b,D);
+    b->inserts += n;
+    stopTimer(b,TIMEINSERT,start);
+}
+extern void setBINOMIALlazy(BINOMIAL *b,int lazy){
+    assert(b != 0);
+    b->lazy = lazy;
+}
+extern int getBINOMIALlazy(BINOMIAL *b){
+    assert(b != 0);
+    return b->lazy;
+}
 extern int sizeBINOMIAL(BINOMIAL *b){
     if (b == 0) return 0;
     return b->size;
 }
 extern void unionBINOMIAL(BINOMIAL * b,BINOMIAL * donor){
     //b and donor are binomial heaps
-    unionDLL(b->rootList,donor->rootList);
-    setBINOMIALsize(b,getBINOMIALsize(b)+getBINOMIALsize(donor));
-    removeDLLall(donor->rootList);
-    setBINOMIALsize(donor,0);
-    setBINOMIALextreme(b,0);
+    if (donor->rootList != 0) appendRoots(b,donor->rootList,donor->roots);
+    // donor's slabs go along with its nodes, b keeps allocating from its own
+    if (donor->slabs != 0){
+        BinomialSLAB * tail = donor->slabs;
+        while (tail->next != 0) tail = tail->next;
+        if (b->slabs == 0){
+            b->slabs = donor->slabs;
+        }
+        else{
+            tail->next = b->slabs->next;
+            b->slabs->next = donor->slabs;
+        }
+        donor->slabs = 0;
+        donor->released = 0;
+    }
+    b->size += donor->size;
+    donor->rootList = 0;
+    donor->roots = 0;
+    donor->extreme = 0;
+    donor->size = 0;
     consolidate(b);
 }
-extern void deleteBINOMIAL(BINOMIAL *b,void *node){
-    decreaseKeyBINOMIAL(b,node,0);
-    extractBINOMIAL(b);
-}
 // Private Helper Function //
-static void * bubbleUp(BINOMIAL * b, BinomialNODE * n){
-    BinomialNODE * p = getBinomialNODEparent(n);
-    if (n == p) return n;
-    assert(n != 0);
-    if (b->compare(getBinomialNODEdata(n),getBinomialNODEdata(p)) >= 0) return n;
-    if (b->update != 0){
-        b->update(getBinomialNODEdata(n),p);
-        b->update(getBinomialNODEdata(p),n);
+// moves n's value up, swapping with its parent while force is set or the value is more extreme
+static BinomialNODE *bubbleUp(BINOMIAL * b,BinomialNODE * n,int force){
+    while (n->parent != 0){
+        BinomialNODE * p = n->parent;
+        if (!force && compareValues(b,n->data,p->data) >= 0) break;
+        if (b->update != 0){
+            b->update(n->data,p);
+            b->update(p->data,n);
+        }
+        void * temp = n->data;
+        n->data = p->data;
+        p->data = temp;
+        n = p;
+        b->levels++;
     }
-    swapperBinomialNODE(n,p);
-    p = getBinomialNODEparent(n);
-    return bubbleUp(b,p);
+    return n;
+}
+static void *extractNODE(BINOMIAL * b,BinomialNODE * y){
+    int64_t start = startTimer(b);
+    removeRoot(b,y);
+    // y's children become roots, ahead of the other roots
+    BinomialNODE * c = y->child;
+    if (c != 0){
+        BinomialNODE * ptr = c;
+        do{
+            ptr->parent = 0;
+            ptr = ptr->right;
+        }while (ptr != c);
+        BinomialNODE * rest = b->rootList;
+        b->rootList = 0;
+        int roots = b->roots;
+        b->roots = 0;
+        appendRoots(b,c,y->degree);
+        if (rest != 0) appendRoots(b,rest,roots);
+    }
+    consolidate(b);
+    void * generic = y->data;
+    releaseBinomialNODE(b,y);
+    b->size--;
+    b->extracts++;
+    stopTimer(b,TIMEEXTRACT,start);
+    return generic;
+}
+// the value is removed from the heap but not freed
+extern void deleteBINOMIAL(BINOMIAL *b,void *node){
+    assert(node != 0);
+    extractNODE(b,bubbleUp(b,node,1));
 }
 
 // Returns the Binomial node it now points to
 extern void decreaseKeyBINOMIAL(BINOMIAL *b,void * node ,void * value){
     assert(node != 0);
+    int64_t start = startTimer(b);
     BinomialNODE * n = (BinomialNODE *)node;
-    setBinomialNODEdata(n,value);
-    BinomialNODE * resultingNode = bubbleUp(b,n);
+    n->data = value;
+    BinomialNODE * resultingNode = bubbleUp(b,n,0);
     // update b's extreme value pointer if necessary)
-    if (b->compare(getBinomialNODEdata(resultingNode),getBinomialNODEdata(getBINOMIALextreme(b))) < 0){
-        setBINOMIALextreme(b,resultingNode);
+    if (compareValues(b,resultingNode->data,b->extreme->data) < 0){
+        b->extreme = resultingNode;
     }
+    b->decreaseKeys++;
+    stopTimer(b,TIMEDECREASE,start);
     return;
 }
+// node i gets values[i], a node must not be given twice
+extern void decreaseKeyBINOMIALbatch(BINOMIAL *b,void **nodes,void **values,int n){
+    assert(b != 0 && n >= 0);
+    int64_t start = startTimer(b);
+    if (n > b->batchCapacity){
+        b->batchCapacity = n;
+        b->batch = realloc(b->batch,sizeof(BinomialNODE *) * n);
+        b->depths = realloc(b->depths,sizeof(int) * n);
+        assert(b->batch != 0 && b->depths != 0);
+    }
+    // a counting sort on the depth, which is below MAXDEGREE
+    int counts[MAXDEGREE + 1] = {0};
+    for (int i = 0; i < n; i++){
+        BinomialNODE * node = nodes[i];
+        node->data = values[i];
+        int depth = 0;
+        for (BinomialNODE * p = node->parent; p != 0; p = p->parent) depth++;
+        b->depths[i] = depth;
+        counts[depth + 1]++;
+    }
+    for (int d = 0; d < MAXDEGREE; d++){
+        counts[d + 1] += counts[d];
+    }
+    for (int i = 0; i < n; i++){
+        b->batch[counts[b->depths[i]]] = nodes[i];
+        counts[b->depths[i]]++;
+    }
+    for (int i = 0; i < n; i++){
+        b->batch[i] = bubbleUp(b,b->batch[i],0);
+    }
+    // only the values that reached a root can be more extreme
+    for (int i = 0; i < n; i++){
+        BinomialNODE * node = b->batch[i];
+        if (node->parent == 0 && node != b->extreme
+                && compareValues(b,node->data,b->extreme->data) < 0){
+            b->extreme = node;
+        }
+    }
+    b->decreaseKeys += n;
+    stopTimer(b,TIMEDECREASE,start);
+}
 extern void *peekBINOMIAL(BINOMIAL *b){
-    assert(b != 0);
-    BinomialNODE * n = getBINOMIALextreme(b);
-    return getBinomialNODEdata(n);
+    assert(b != 0 && b->extreme != 0);
+    return b->extreme->data;
 }
 extern void *extractBINOMIAL(BINOMIAL *b){
-    BinomialNODE * y = getBINOMIALextreme(b);
-    removeDLLnode(getBINOMIALrootList(b),getBinomialNODEowner(y));
-    // set each of the y's children's parent to point to themselves
-    DLL * childrenDLL = getBinomialNODEchildren(y);
-    firstDLL(childrenDLL);
-    BinomialNODE * c = 0;
-    int s = sizeDLL(childrenDLL);
-    for (int a = 0; a < s; a++){
-        c = currentDLL(childrenDLL);
-        setBinomialNODEparent(c,c);
-        nextDLL(childrenDLL);
-    }
-    unionDLL(childrenDLL,getBINOMIALrootList(b));
-    unionDLL(getBINOMIALrootList(b),childrenDLL);
-    consolidate(b);
-    assert(y != 0);
-    void * generic = getBinomialNODEdata(y);
-    freeDLL(getBinomialNODEchildren(y));
-    free((BinomialNODE*)y);
-    setBINOMIALsize(b,getBINOMIALsize(b)-1);
-    return generic;
+    assert(b != 0 && b->extreme != 0);
+    return extractNODE(b,b->extreme);
 }
 extern void statisticsBINOMIAL(BINOMIAL *b,FILE *fp){
-    fprintf(fp,"size: %d\n",getBINOMIALsize(b));
-    fprintf(fp,"rootlist size: %d\n",(sizeDLL(getBINOMIALrootList(b))));
+    fprintf(fp,"size: %d\n",b->size);
+    fprintf(fp,"rootlist size: %d\n",b->roots);
     fprintf(fp,"extreme: ");
-    if (getBINOMIALextreme(b) != 0) displayBINOMIALnode(getBINOMIALextreme(b),fp);
+    if (b->extreme != 0) displayBINOMIALnode(b,b->extreme,fp);
     else fprintf(fp,"NULL");
+    fprintf(fp,"\ninserts: %lld\n",b->inserts);
+    fprintf(fp,"extracts: %lld\n",b->extracts);
+    fprintf(fp,"decreaseKeys: %lld\n",b->decreaseKeys);
+    fprintf(fp,"consolidates: %lld\n",b->consolidates);
+    fprintf(fp,"comparisons: %lld\n",b->comparisons);
+    fprintf(fp,"bubbleUp levels: %lld\n",b->levels);
+    fprintf(fp,"longest rootlist: %d",b->maxRoots);
+    if (!b->timing) return;
+    long long counts[TIMERS] = {b->inserts,b->extracts,b->decreaseKeys,b->consolidates};
+    for (int i = 0; i < TIMERS; i++){
+        double seconds = b->nanoseconds[i] / 1e9;
+        double each = (counts[i] == 0) ? 0 : (double)b->nanoseconds[i] / counts[i];
+        fprintf(fp,"\n%s time: %.6fs, %.1fns each",timerNames[i],seconds,each);
+    }
+}
+extern void setBINOMIALtiming(BINOMIAL *b,int timing){
+    assert(b != 0);
+    b->timing = timing;
 }
 extern void displayBINOMIAL(BINOMIAL *b,FILE *fp){
-    if (getBINOMIALsize(b) == 0){
+    if (b->size == 0){
         fprintf(fp,"EMPTY\n");
         return;
     }
     fprintf(fp,"rootlist: ");
-    DLL * list = getBINOMIALrootList(b);
-    BinomialNODE * ptr = 0;
+    BinomialNODE * ptr = b->rootList;
     int degree = 0;
     int count = 0;
-    
-    firstDLL(list);
+
     while (1){
-        ptr = currentDLL(list);
-        if (getBinomialNODEdegree(ptr) == degree){
-            displayBINOMIALnode(ptr,fp);
-            if (ptr == getBINOMIALextreme(b)){
+        if (ptr->degree == degree){
+            displayBINOMIALnode(b,ptr,fp);
+            if (ptr == b->extreme){
                 fprintf(fp,"*");
             }
             count++;
-            if (count == sizeDLL(list)) break;
-            nextDLL(list);
+            if (count == b->roots) break;
+            ptr = ptr->right;
         }
         else{
             fprintf(fp,"NULL");
@@ -390,28 +506,25 @@ extern void displayBINOMIAL(BINOMIAL *b,FILE *fp){
 }
 extern void displayBINOMIALdebug(BINOMIAL *b,FILE *fp){
     /*Base Case*/
-    if (getBINOMIALsize(b) < 1) return;
+    if (b->size < 1) return;
     /*Create an empty QUEUE*/
     QUEUE * linkedList = newQUEUE(0,0);
-    /*Enqueue the root and initialize the height*/
-    enqueue(linkedList,getBINOMIALrootList(b));
+    /*Enqueue the root ring and initialize the height*/
+    enqueue(linkedList,b->rootList);
     while (1){
         int nodeCountAtLevel = sizeQUEUE(linkedList);
         if (nodeCountAtLevel == 0) break;
         while (nodeCountAtLevel > 0){
-            DLL * list = dequeue(linkedList);
-            if (b->display){
-                displayDLL(list,fp);
-            }
-            firstDLL(list);
-            for (int a = 0; a < sizeDLL(list); a++){
-                BinomialNODE * ptr = currentDLL(list);
-                assert(ptr != 0);
-                if (sizeDLL(getBinomialNODEchildren(ptr)) > 0){
-                    enqueue(linkedList,getBinomialNODEchildren(ptr));
-                }
-                nextDLL(list);
-            }
+            BinomialNODE * first = dequeue(linkedList);
+            BinomialNODE * ptr = first;
+            fprintf(fp,"{{");
+            do{
+                displayBINOMIALnode(b,ptr,fp);
+                if (ptr->child != 0) enqueue(linkedList,ptr->child);
+                ptr = ptr->right;
+                if (ptr != first) fprintf(fp,",");
+            }while (ptr != first);
+            fprintf(fp,"}}");
             nodeCountAtLevel--;
         }
         fprintf(fp,"\n");
@@ -421,22 +534,24 @@ extern void displayBINOMIALdebug(BINOMIAL *b,FILE *fp){
 }
 extern void freeBINOMIAL(BINOMIAL *b){
     assert(b != 0);
-    BinomialNODE * ptr = 0;
-    QUEUE * linkedList = newQUEUE(0,0);
-    DLL * level = 0;
-    enqueue(linkedList,getBINOMIALrootList(b));
-    while (sizeQUEUE(linkedList) != 0){
-        level = dequeue(linkedList);
-        if (sizeDLL(level) > 0){
-            firstDLL(level);
-            for (int a = 0; a < sizeDLL(level); a++){
-                ptr = currentDLL(level);
-                enqueue(linkedList,getBinomialNODEchildren(ptr));
-                nextDLL(level);
-            }
+    // children are spliced into the root ring as their parents are freed
+    BinomialNODE * ptr = b->rootList;
+    while (ptr != 0){
+        if (ptr->child != 0){
+            spliceRing(ptr,ptr->child);
+            ptr->child = 0;
         }
-        freeDLL(level);
+        BinomialNODE * next = (ptr->right == ptr) ? 0 : ptr->right;
+        removeFromRing(ptr);
+        if (b->free != 0 && ptr->data != 0) b->free(ptr->data);
+        ptr = next;
     }
-    freeQUEUE(linkedList);
+    while (b->slabs != 0){
+        BinomialSLAB * next = b->slabs->next;
+        free(b->slabs);
+        b->slabs = next;
+    }
+    free(b->batch);
+    free(b->depths);
     free((BINOMIAL *)b);
 }
@@ -11,13 +11,18 @@ extern BINOMIAL *newBINOMIAL(
         void (*update)(void *,void *),
         void (*free)(void *));
 void *insertBINOMIAL(BINOMIAL *b,void *value);
+extern void buildBINOMIAL(BINOMIAL *b,void **values,int n);
+extern void setBINOMIALlazy(BINOMIAL *b,int lazy);
+extern int getBINOMIALlazy(BINOMIAL *b);
 extern int sizeBINOMIAL(BINOMIAL *b);
 extern void unionBINOMIAL(BINOMIAL *,BINOMIAL *);
 extern void deleteBINOMIAL(BINOMIAL *b,void *node);
 extern void decreaseKeyBINOMIAL(BINOMIAL *b,void *node,void *value);
+extern void decreaseKeyBINOMIALbatch(BINOMIAL *b,void **nodes,void **values,int n);
 extern void *peekBINOMIAL(BINOMIAL *b);
 extern void *extractBINOMIAL(BINOMIAL *b);
 extern void statisticsBINOMIAL(BINOMIAL *b,FILE *fp);
+extern void setBINOMIALtiming(BINOMIAL *b,int timing);
 extern void displayBINOMIAL(BINOMIAL *b,FILE *fp);
 extern void displayBINOMIALdebug(BINOMIAL *b,FILE *fp);
 extern void freeBINOMIAL(BINOMIAL *b);
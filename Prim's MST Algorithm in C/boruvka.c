@@ -0,0 +1,232 @@
+/*
+ *  Boruvka's algorithm over a CSR, run on a POOL of threads. Each round
+ *
+ *      every edge offers itself to the components at both of its ends,
+ *      each component keeping the cheapest offer with an atomic minimum,
+ *
+ *      every component joins along its cheapest edge, through a union
+ *      find whose links are made with compare and swap, the edges that
+ *      really join two trees going into the forest,
+ *
+ *      the edges are rewritten between the roots of their components and
+ *      those now inside one component are dropped.
+ *
+ *  The number of components at least halves every round, so there are at
+ *  most log2 V rounds, each a few parallel passes over the edges left.
+ *
+ *  Edges are ordered by weight and then by their position in the edge
+ *  list, packed into one 64 bit word, so no two edges tie. That keeps the
+ *  cheapest edges of a round from closing a cycle, and the forest is the
+ *  one kruskal finds with the same order, of the same weight as prim's.
+ *
+ *  With a timing file, one line per round is written to it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include <time.h>
+#include "boruvka.h"
+
+#define NOEDGE UINT64_MAX
+
+typedef struct boruvkaedge{
+    int v1;     // the roots of the components the edge joins, once contracted
+    int v2;
+    int weight;
+    uint32_t id;    // position in the first edge list, to break ties
+}BORUVKAEDGE;
+
+typedef struct boruvka{
+    BORUVKAEDGE * edges;
+    BORUVKAEDGE * kept;     // the edges that survive a round
+    int64_t count;
+    int * parent;           // the concurrent union find
+    uint64_t * cheapest;    // the best offer to each component
+    BORUVKAEDGE * original; // the first edge list, indexed by id
+    MSTEDGE * tree;
+    int treeSize;
+    int64_t * keptCounts;   // edges kept by each worker
+    int vertices;
+}BORUVKA;
+
+/// Private helper FUNCTIONS ///
+static uint64_t offer(BORUVKAEDGE * e){
+    // flipping the sign bit orders signed weights as unsigned ones
+    uint32_t weight = (uint32_t)e->weight ^ 0x80000000u;
+    return ((uint64_t)weight << 32) | e->id;
+}
+static int findRoot(BORUVKA * b,int x){
+    while (1){
+        int p = __atomic_load_n(&b->parent[x],__ATOMIC_RELAXED);
+        if (p == x) return x;
+        int grand = __atomic_load_n(&b->parent[p],__ATOMIC_RELAXED);
+        // path halving, losing the race only leaves a longer path
+        if (grand != p) __atomic_compare_exchange_n(&b->parent[x],&p,grand,0,__ATOMIC_RELAXED,__ATOMIC_RELAXED);
+        x = grand;
+    }
+}
+// returns 1 if x and y were in different components
+static int joinRoots(BORUVKA * b,int x,int y){
+    while (1){
+        x = findRoot(b,x);
+        y = findRoot(b,y);
+        if (x == y) return 0;
+        // the larger root goes under the smaller one
+        if (x < y){
+            int temp = x;
+            x = y;
+            y = temp;
+        }
+        int expected = x;
+        if (__atomic_compare_exchange_n(&b->parent[x],&expected,y,0,__ATOMIC_ACQ_REL,__ATOMIC_RELAXED)) return 1;
+    }
+}
+static void offerMinimum(uint64_t * slot,uint64_t value){
+    uint64_t current = __atomic_load_n(slot,__ATOMIC_RELAXED);
+    while (value < current){
+        if (__atomic_compare_exchange_n(slot,&current,value,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) return;
+    }
+}
+static double seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+//// the parallel passes ////
+static void offerEdges(void * arg,int64_t begin,int64_t end,int worker){
+    BORUVKA * b = arg;
+    (void)worker;
+    for (int64_t e = begin; e < end; e++){
+        uint64_t value = offer(&b->edges[e]);
+        offerMinimum(&b->cheapest[b->edges[e].v1],value);
+        offerMinimum(&b->cheapest[b->edges[e].v2],value);
+    }
+}
+static void joinCheapest(void * arg,int64_t begin,int64_t end,int worker){
+    BORUVKA * b = arg;
+    (void)worker;
+    for (int64_t v = begin; v < end; v++){
+        uint64_t value = b->cheapest[v];
+        if (value == NOEDGE) continue;
+        b->cheapest[v] = NOEDGE;
+        BORUVKAEDGE * e = &b->original[value & 0xffffffffu];
+        if (joinRoots(b,e->v1,e->v2)){
+            int slot = __atomic_fetch_add(&b->treeSize,1,__ATOMIC_RELAXED);
+            b->tree[slot].v1 = e->v1;
+            b->tree[slot].v2 = e->v2;
+            b->tree[slot].weight = e->weight;
+        }
+    }
+}
+// contracts the edges of a slice in place, counting the ones kept
+static void contractEdges(void * arg,int64_t begin,int64_t end,int worker){
+    BORUVKA * b = arg;
+    int64_t kept = begin;
+    for (int64_t e = begin; e < end; e++){
+        BORUVKAEDGE edge = b->edges[e];
+        edge.v1 = findRoot(b,edge.v1);
+        edge.v2 = findRoot(b,edge.v2);
+        if (edge.v1 == edge.v2) continue;
+        b->edges[kept++] = edge;
+    }
+    b->keptCounts[worker] = kept - begin;
+}
+typedef struct compaction{
+    BORUVKA * b;
+    int64_t * targets;  // where the edges kept by each slice go
+    int threads;
+    int64_t count;      // edges the contraction was run over
+}COMPACTION;
+// one item per slice of the contraction
+static void compactEdges(void * arg,int64_t begin,int64_t end,int worker){
+    COMPACTION * c = arg;
+    (void)worker;
+    for (int64_t t = begin; t < end; t++){
+        int64_t from = c->count * t / c->threads;
+        memcpy(c->b->kept + c->targets[t],c->b->edges + from,sizeof(BORUVKAEDGE) * c->b->keptCounts[t]);
+    }
+}
+
+///// PUBLIC FUNCTIONS ////
+// fills tree with the edges of a minimum spanning forest and returns how many
+// tree needs room for one edge less than there are vertices
+extern int boruvkaMST(CSR * graph,MSTEDGE * tree,POOL * pool,FILE * timing){
+    BORUVKA b;
+    int vertices = sizeCSR(graph);
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
+    int64_t edges = arcsCSR(graph) / 2;
+    assert(edges <= UINT32_MAX);
+    int threads = threadsPOOL(pool);
+    b.vertices = vertices;
+    b.original = malloc(sizeof(BORUVKAEDGE) * (edges + 1));
+    b.edges = malloc(sizeof(BORUVKAEDGE) * (edges + 1));
+    b.kept = malloc(sizeof(BORUVKAEDGE) * (edges + 1));
+    b.parent = malloc(sizeof(int) * (vertices + 1));
+    b.cheapest = malloc(sizeof(uint64_t) * (vertices + 1));
+    b.keptCounts = malloc(sizeof(int64_t) * threads);
+    int64_t * targets = malloc(sizeof(int64_t) * (threads + 1));
+    assert(b.original != 0 && b.edges != 0 && b.kept != 0 && b.parent != 0);
+    assert(b.cheapest != 0 && b.keptCounts != 0 && targets != 0);
+    b.count = 0;
+    for (int u = 0; u < vertices; u++){
+        for (int64_t a = offsets[u]; a < offsets[u + 1]; a++){
+            if (arcs[a].vertex <= u) continue;
+            BORUVKAEDGE * e = &b.original[b.count];
+            e->v1 = u;
+            e->v2 = arcs[a].vertex;
+            e->weight = arcs[a].weight;
+            e->id = b.count;
+            b.count++;
+        }
+    }
+    memcpy(b.edges,b.original,sizeof(BORUVKAEDGE) * b.count);
+    for (int v = 0; v < vertices; v++){
+        b.parent[v] = v;
+        b.cheapest[v] = NOEDGE;
+    }
+    b.tree = tree;
+    b.treeSize = 0;
+    int round = 0;
+    while (b.count > 0){
+        double started = seconds();
+        int64_t count = b.count;
+        runPOOL(pool,offerEdges,&b,b.count);
+        runPOOL(pool,joinCheapest,&b,vertices);
+        // every slice contracts in place, then the slices are packed together
+        for (int t = 0; t < threads; t++){
+            b.keptCounts[t] = 0;
+        }
+        runPOOL(pool,contractEdges,&b,b.count);
+        targets[0] = 0;
+        for (int t = 0; t < threads; t++){
+            targets[t + 1] = targets[t] + b.keptCounts[t];
+        }
+        COMPACTION c = {&b,targets,threads,b.count};
+        runPOOL(pool,compactEdges,&c,threads);
+        BORUVKAEDGE * swap = b.edges;
+        b.edges = b.kept;
+        b.kept = swap;
+        b.count = targets[threads];
+        round++;
+        if (timing != 0){
+            fprintf(timing,"boruvka round %d: %lld edges, %d tree edges, %.6fs\n",
+                    round,(long long)count,b.treeSize,seconds() - started);
+        }
+    }
+    free(b.original);
+    free(b.edges);
+    free(b.kept);
+    free(b.parent);
+    free(b.cheapest);
+    free(b.keptCounts);
+    free(targets);
+    return b.treeSize;
+}
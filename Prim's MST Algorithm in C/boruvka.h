@@ -0,0 +1,11 @@
+#ifndef __BORUVKA_INCLUDED__
+#define __BORUVKA_INCLUDED__
+
+#include <stdio.h>
+#include "csr.h"
+#include "kruskal.h"
+#include "pool.h"
+
+extern int boruvkaMST(CSR *graph,MSTEDGE *tree,POOL *pool,FILE *timing);
+
+#endif
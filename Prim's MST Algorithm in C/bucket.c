@@ -0,0 +1,173 @@
+/*
+ *  A bucket queue over the dense vertex indices 0..capacity-1 whose keys
+ *  are the integers 0..keys-1. Every key has a bucket, a doubly linked
+ *  list threaded through next and prev arrays indexed by vertex, so
+ *  insert and decreaseKey are O(1) and nothing is allocated after
+ *  construction.
+ *
+ *  The smallest key in use is found through an occupancy bitmap kept in
+ *  levels: bit k of level 0 is set when bucket k is not empty, and bit w
+ *  of level l+1 when word w of level l is not zero. The top level is a
+ *  single word, so the minimum is one count trailing zeros per level,
+ *  three levels covering 262144 keys.
+ *
+ *  Keys are compared as integers only, ties within a bucket come out last
+ *  in first out rather than by vertex number.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "bucket.h"
+
+#define MAXLEVELS 6     // 64^6 keys is more than an int can hold
+
+struct bucket{
+    int * head;         // first vertex of each bucket, -1 if it is empty
+    int * next;         // links of each vertex within its bucket
+    int * prev;
+    int * key;          // bucket of each vertex, -1 if it is not in the queue
+    uint64_t * bits[MAXLEVELS];
+    int levels;
+    int size;
+    int capacity;
+    int keys;
+};
+
+//Constructor
+extern BUCKET *newBUCKET(int capacity,int keys){
+    assert(capacity >= 0 && keys > 0);
+    BUCKET * b = malloc(sizeof(BUCKET));
+    assert(b != 0);
+    b->head = malloc(sizeof(int) * keys);
+    b->next = malloc(sizeof(int) * (capacity + 1));
+    b->prev = malloc(sizeof(int) * (capacity + 1));
+    b->key = malloc(sizeof(int) * (capacity + 1));
+    assert(b->head != 0 && b->next != 0 && b->prev != 0 && b->key != 0);
+    for (int k = 0; k < keys; k++){
+        b->head[k] = -1;
+    }
+    for (int i = 0; i < capacity; i++){
+        b->key[i] = -1;
+    }
+    // one bit per key, then one bit per word of the level below
+    int64_t width = keys;
+    b->levels = 0;
+    do{
+        int64_t words = (width + 63) / 64;
+        b->bits[b->levels] = calloc(words,sizeof(uint64_t));
+        assert(b->bits[b->levels] != 0);
+        b->levels++;
+        width = words;
+    }while (width > 1);
+    b->size = 0;
+    b->capacity = capacity;
+    b->keys = keys;
+    return b;
+}
+
+/// Private helper FUNCTIONS ///
+static void markKey(BUCKET * b,int key){
+    for (int l = 0; l < b->levels; l++){
+        uint64_t * word = &b->bits[l][key >> 6];
+        int wasZero = (*word == 0);
+        *word |= (uint64_t)1 << (key & 63);
+        if (!wasZero) return;
+        key >>= 6;
+    }
+}
+static void unmarkKey(BUCKET * b,int key){
+    for (int l = 0; l < b->levels; l++){
+        uint64_t * word = &b->bits[l][key >> 6];
+        *word &= ~((uint64_t)1 << (key & 63));
+        if (*word != 0) return;
+        key >>= 6;
+    }
+}
+static int smallestKey(BUCKET * b){
+    int key = 0;
+    for (int l = b->levels - 1; l >= 0; l--){
+        key = (key << 6) + __builtin_ctzll(b->bits[l][key]);
+    }
+    return key;
+}
+static void link(BUCKET * b,int vertex,int key){
+    int first = b->head[key];
+    b->prev[vertex] = -1;
+    b->next[vertex] = first;
+    if (first != -1) b->prev[first] = vertex;
+    else markKey(b,key);
+    b->head[key] = vertex;
+    b->key[vertex] = key;
+}
+static void unlink(BUCKET * b,int vertex){
+    int key = b->key[vertex];
+    int before = b->prev[vertex];
+    int after = b->next[vertex];
+    if (before != -1) b->next[before] = after;
+    else b->head[key] = after;
+    if (after != -1) b->prev[after] = before;
+    if (b->head[key] == -1) unmarkKey(b,key);
+    b->key[vertex] = -1;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void insertBUCKET(BUCKET * b,int vertex,int key){
+    assert(vertex >= 0 && vertex < b->capacity && b->key[vertex] == -1);
+    assert(key >= 0 && key < b->keys);
+    link(b,vertex,key);
+    b->size++;
+}
+extern void decreaseKeyBUCKET(BUCKET * b,int vertex,int key){
+    assert(b->key[vertex] != -1 && key >= 0 && key <= b->key[vertex]);
+    if (key == b->key[vertex]) return;
+    unlink(b,vertex);
+    link(b,vertex,key);
+}
+extern int containsBUCKET(BUCKET * b,int vertex){
+    return b->key[vertex] != -1;
+}
+extern int peekBUCKET(BUCKET * b){
+    assert(b->size > 0);
+    return b->head[smallestKey(b)];
+}
+extern int extractBUCKET(BUCKET * b){
+    assert(b->size > 0);
+    int vertex = b->head[smallestKey(b)];
+    unlink(b,vertex);
+    b->size--;
+    return vertex;
+}
+extern int sizeBUCKET(BUCKET * b){
+    if (b == 0) return 0;
+    return b->size;
+}
+extern void displayBUCKET(BUCKET * b,FILE * fp){
+    if (b->size == 0){
+        fprintf(fp,"EMPTY\n");
+        return;
+    }
+    int printed = 0;
+    for (int k = 0; k < b->keys; k++){
+        if (b->head[k] == -1) continue;
+        if (printed) fprintf(fp," ");
+        fprintf(fp,"%d:",k);
+        for (int i = b->head[k]; i != -1; i = b->next[i]){
+            fprintf(fp," %d",i);
+        }
+        printed = 1;
+    }
+    fprintf(fp,"\n");
+}
+extern void freeBUCKET(BUCKET * b){
+    assert(b != 0);
+    for (int l = 0; l < b->levels; l++){
+        free(b->bits[l]);
+    }
+    free(b->head);
+    free(b->next);
+    free(b->prev);
+    free(b->key);
+    free((BUCKET *)b);
+}
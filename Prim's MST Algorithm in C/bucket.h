@@ -0,0 +1,18 @@
+#ifndef __BUCKET_INCLUDED__
+#define __BUCKET_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct bucket BUCKET;
+
+extern BUCKET *newBUCKET(int capacity,int keys);
+extern void insertBUCKET(BUCKET *b,int vertex,int key);
+extern void decreaseKeyBUCKET(BUCKET *b,int vertex,int key);
+extern int containsBUCKET(BUCKET *b,int vertex);
+extern int peekBUCKET(BUCKET *b);
+extern int extractBUCKET(BUCKET *b);
+extern int sizeBUCKET(BUCKET *b);
+extern void displayBUCKET(BUCKET *b,FILE *fp);
+extern void freeBUCKET(BUCKET *b);
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ *  The connected COMPONENTS of a CSR, found breadth first. Components are
+ *  numbered in the order of their first vertex and list their members in
+ *  index order, so component 0 holds the source vertex and every component
+ *  starts with the vertex of it that was read first.
+ *
+ *  getCOMPONENTScsr copies one component out into a CSR of its own, its
+ *  vertices numbered 0..size-1 in the order of the members and keeping
+ *  their ids, so it can be worked on apart from the rest of the graph.
+ *  getCOMPONENTSorder lists the components largest first, the order to
+ *  hand them out to threads in.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "components.h"
+
+struct components{
+    int count;
+    int * label;    // the component of each vertex
+    int * local;    // the position of each vertex among the members of its component
+    int * start;    // component k is members[start[k]]..members[start[k+1]-1]
+    int * members;
+    int * order;    // the components, largest first
+};
+
+/// Private helper FUNCTIONS ///
+// labels every vertex, returning how many components there are
+static int labelVertices(COMPONENTS * c,CSR * graph){
+    int vertices = sizeCSR(graph);
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
+    int * queue = malloc(sizeof(int) * (vertices + 1));
+    assert(queue != 0);
+    for (int i = 0; i < vertices; i++){
+        c->label[i] = -1;
+    }
+    int count = 0;
+    for (int root = 0; root < vertices; root++){
+        if (c->label[root] != -1) continue;
+        int head = 0;
+        int tail = 0;
+        c->label[root] = count;
+        queue[tail++] = root;
+        while (head < tail){
+            int u = queue[head++];
+            for (int64_t a = offsets[u]; a < offsets[u + 1]; a++){
+                int v = arcs[a].vertex;
+                if (c->label[v] != -1) continue;
+                c->label[v] = count;
+                queue[tail++] = v;
+            }
+        }
+        count++;
+    }
+    free(queue);
+    return count;
+}
+// counting sorts on the sizes, the components of one size staying in order
+static void orderComponents(COMPONENTS * c,int vertices){
+    int * bySize = calloc(vertices + 2,sizeof(int));
+    assert(bySize != 0);
+    for (int k = 0; k < c->count; k++){
+        bySize[vertices - sizeCOMPONENTS(c,k) + 1]++;
+    }
+    for (int s = 0; s <= vertices; s++){
+        bySize[s + 1] += bySize[s];
+    }
+    for (int k = 0; k < c->count; k++){
+        c->order[bySize[vertices - sizeCOMPONENTS(c,k)]++] = k;
+    }
+    free(bySize);
+}
+
+//Constructor
+extern COMPONENTS *newCOMPONENTS(CSR * graph){
+    assert(graph != 0);
+    int vertices = sizeCSR(graph);
+    COMPONENTS * c = malloc(sizeof(COMPONENTS));
+    assert(c != 0);
+    c->label = malloc(sizeof(int) * (vertices + 1));
+    c->local = malloc(sizeof(int) * (vertices + 1));
+    c->members = malloc(sizeof(int) * (vertices + 1));
+    assert(c->label != 0 && c->local != 0 && c->members != 0);
+    c->count = labelVertices(c,graph);
+    c->start = calloc(c->count + 1,sizeof(int));
+    c->order = malloc(sizeof(int) * (c->count + 1));
+    assert(c->start != 0 && c->order != 0);
+    // the members are counting sorted on the label, keeping index order
+    for (int i = 0; i < vertices; i++){
+        c->start[c->label[i] + 1]++;
+    }
+    for (int k = 0; k < c->count; k++){
+        c->start[k + 1] += c->start[k];
+    }
+    int * fill = malloc(sizeof(int) * (c->count + 1));
+    assert(fill != 0);
+    for (int k = 0; k < c->count; k++){
+        fill[k] = c->start[k];
+    }
+    for (int i = 0; i < vertices; i++){
+        int k = c->label[i];
+        c->local[i] = fill[k] - c->start[k];
+        c->members[fill[k]++] = i;
+    }
+    free(fill);
+    orderComponents(c,vertices);
+    return c;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int countCOMPONENTS(COMPONENTS * c){
+    assert(c != 0);
+    return c->count;
+}
+extern int sizeCOMPONENTS(COMPONENTS * c,int k){
+    assert(k >= 0 && k < c->count);
+    return c->start[k + 1] - c->start[k];
+}
+// the vertex indices of component k, sizeCOMPONENTS of them
+extern int *getCOMPONENTSmembers(COMPONENTS * c,int k){
+    assert(k >= 0 && k < c->count);
+    return c->members + c->start[k];
+}
+extern int *getCOMPONENTSorder(COMPONENTS * c){
+    assert(c != 0);
+    return c->order;
+}
+// a new CSR holding component k, vertex i of it being member i
+extern CSR *getCOMPONENTScsr(COMPONENTS * c,CSR * graph,int k){
+    int size = sizeCOMPONENTS(c,k);
+    int * members = getCOMPONENTSmembers(c,k);
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
+    int * ids = getCSRids(graph);
+    int64_t count = 0;
+    for (int i = 0; i < size; i++){
+        count += offsets[members[i] + 1] - offsets[members[i]];
+    }
+    CSR * component = newCSR(size,count);
+    int * componentIds = getCSRids(component);
+    int64_t * componentOffsets = getCSRoffsets(component);
+    CSRARC * componentArcs = getCSRarcs(component);
+    count = 0;
+    for (int i = 0; i < size; i++){
+        int u = members[i];
+        componentIds[i] = ids[u];
+        componentOffsets[i] = count;
+        for (int64_t a = offsets[u]; a < offsets[u + 1]; a++){
+            componentArcs[count].vertex = c->local[arcs[a].vertex];
+            componentArcs[count].weight = arcs[a].weight;
+            count++;
+        }
+    }
+    componentOffsets[size] = count;
+    return component;
+}
+extern void freeCOMPONENTS(COMPONENTS * c){
+    assert(c != 0);
+    free(c->label);
+    free(c->local);
+    free(c->start);
+    free(c->members);
+    free(c->order);
+    free((COMPONENTS *)c);
+}
@@ -0,0 +1,17 @@
+#ifndef __COMPONENTS_INCLUDED__
+#define __COMPONENTS_INCLUDED__
+
+#include <stdio.h>
+#include "csr.h"
+
+typedef struct components COMPONENTS;
+
+extern COMPONENTS *newCOMPONENTS(CSR *graph);
+extern int countCOMPONENTS(COMPONENTS *c);
+extern int sizeCOMPONENTS(COMPONENTS *c,int k);
+extern int *getCOMPONENTSmembers(COMPONENTS *c,int k);
+extern int *getCOMPONENTSorder(COMPONENTS *c);
+extern CSR *getCOMPONENTScsr(COMPONENTS *c,CSR *graph,int k);
+extern void freeCOMPONENTS(COMPONENTS *c);
+
+#endif
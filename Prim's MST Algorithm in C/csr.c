@@ -0,0 +1,196 @@
+/*
+ *  A compressed sparse row (CSR) graph. Vertices are numbered 0..V-1 in
+ *  the order they were first read, vertex 0 being the source. The arcs of
+ *  vertex i are arcs[offsets[i]] up to arcs[offsets[i+1]], every edge
+ *  appearing once from each end, and ids[i] is the number vertex i had in
+ *  the input.
+ *
+ *  A CSR can be written to a binary graph file and loaded back later with
+ *  no parsing at all: loadCSR maps the file and points straight into it,
+ *  so a loaded CSR is read only. It still reads the offsets and arcs once
+ *  to check them, so a damaged file is turned down rather than read past
+ *  its end. The file holds, in native byte order,
+ *
+ *      header    magic, version, byte order mark, vertices, arcs
+ *      ids       int32 per vertex, padded to a multiple of 8 bytes
+ *      offsets   int64 per vertex plus one
+ *      arcs      (int32 neighbor, int32 weight) per arc
+ *
+ *  The duplicate edges have already been dropped when the file is written.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/stat.h>
+#include "csr.h"
+#include "mapping.h"
+
+#define CSR_MAGIC "PRIMCSR"
+#define CSR_VERSION 1
+#define CSR_BYTEORDER 0x01020304
+
+typedef struct csrheader{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    int64_t vertices;
+    int64_t arcs;
+}CSRHEADER;
+
+struct csr{
+    int size;
+    int64_t arcCount;
+    int * ids;
+    int64_t * offsets;
+    CSRARC * arcs;
+    MAPPING * mapping;  // non zero if the arrays point into a mapped file
+};
+
+/// Private helper FUNCTIONS ///
+static size_t idsBytes(int64_t vertices){
+    return (vertices * sizeof(int32_t) + 7) / 8 * 8;
+}
+static size_t fileBytes(int64_t vertices,int64_t arcs){
+    return sizeof(CSRHEADER) + idsBytes(vertices)
+        + (vertices + 1) * sizeof(int64_t) + arcs * sizeof(CSRARC);
+}
+// whether a header's counts give a file of size bytes; each count is held
+// to what size could hold first, so fileBytes cannot wrap around
+static int fitsCSR(int64_t vertices,int64_t arcs,size_t size){
+    if (vertices < 0 || vertices >= 0x7fffffff || arcs < 0) return 0;
+    if ((uint64_t)vertices > size / sizeof(int64_t) || (uint64_t)arcs > size / sizeof(CSRARC)) return 0;
+    return size == fileBytes(vertices,arcs);
+}
+// whether the offsets run from 0 to the arc count without going back and
+// every arc leads to a vertex there is, so nothing reads past the arrays
+static int validCSR(CSR * c){
+    if (c->offsets[0] != 0 || c->offsets[c->size] != c->arcCount) return 0;
+    for (int v = 0; v < c->size; v++){
+        if (c->offsets[v] > c->offsets[v + 1]) return 0;
+    }
+    for (int64_t a = 0; a < c->arcCount; a++){
+        if (c->arcs[a].vertex < 0 || c->arcs[a].vertex >= c->size) return 0;
+    }
+    return 1;
+}
+
+//Constructor, the caller fills in the arrays
+extern CSR *newCSR(int vertices,int64_t arcs){
+    CSR * c = malloc(sizeof(CSR));
+    assert(c != 0);
+    c->size = vertices;
+    c->arcCount = arcs;
+    c->ids = malloc(sizeof(int) * (vertices + 1));
+    c->offsets = malloc(sizeof(int64_t) * (vertices + 1));
+    c->arcs = malloc(sizeof(CSRARC) * (arcs + 1));
+    assert(c->ids != 0 && c->offsets != 0 && c->arcs != 0);
+    c->offsets[0] = 0;
+    c->mapping = 0;
+    return c;
+}
+// only regular files are looked at, peeking into a pipe would consume it
+extern int isCSRfile(char * filename){
+    char magic[8];
+    struct stat info;
+    if (stat(filename,&info) != 0 || !S_ISREG(info.st_mode)) return 0;
+    FILE * fp = fopen(filename,"rb");
+    if (fp == 0) return 0;
+    int found = fread(magic,1,sizeof(magic),fp) == sizeof(magic)
+        && memcmp(magic,CSR_MAGIC,sizeof(magic)) == 0;
+    fclose(fp);
+    return found;
+}
+// returns 0 if the file cannot be mapped or is not a valid binary graph
+extern CSR *loadCSR(char * filename){
+    MAPPING * m = newMAPPING(filename);
+    if (m == 0) return 0;
+    const char * data = getMAPPINGdata(m);
+    size_t size = sizeMAPPING(m);
+    CSRHEADER header;
+    if (size < sizeof(header)){
+        freeMAPPING(m);
+        return 0;
+    }
+    memcpy(&header,data,sizeof(header));
+    if (memcmp(header.magic,CSR_MAGIC,sizeof(header.magic)) != 0
+            || header.version != CSR_VERSION || header.byteOrder != CSR_BYTEORDER
+            || !fitsCSR(header.vertices,header.arcs,size)){
+        freeMAPPING(m);
+        return 0;
+    }
+    adviseMAPPING(m,MAPPING_WILLNEED);
+    CSR * c = malloc(sizeof(CSR));
+    assert(c != 0);
+    c->size = header.vertices;
+    c->arcCount = header.arcs;
+    data += sizeof(header);
+    c->ids = (int *)data;
+    data += idsBytes(header.vertices);
+    c->offsets = (int64_t *)data;
+    data += (header.vertices + 1) * sizeof(int64_t);
+    c->arcs = (CSRARC *)data;
+    c->mapping = m;
+    if (!validCSR(c)){
+        freeCSR(c);
+        return 0;
+    }
+    return c;
+}
+// returns 0 if the file could not be written
+extern int writeCSR(CSR * c,char * filename){
+    assert(c != 0);
+    FILE * fp = fopen(filename,"wb");
+    if (fp == 0) return 0;
+    CSRHEADER header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,CSR_MAGIC,sizeof(header.magic));
+    header.version = CSR_VERSION;
+    header.byteOrder = CSR_BYTEORDER;
+    header.vertices = c->size;
+    header.arcs = c->arcCount;
+    static const char padding[8] = {0};
+    size_t pad = idsBytes(c->size) - c->size * sizeof(int32_t);
+    int ok = fwrite(&header,sizeof(header),1,fp) == 1
+        && fwrite(c->ids,sizeof(int32_t),c->size,fp) == (size_t)c->size
+        && fwrite(padding,1,pad,fp) == pad
+        && fwrite(c->offsets,sizeof(int64_t),c->size + 1,fp) == (size_t)c->size + 1
+        && fwrite(c->arcs,sizeof(CSRARC),c->arcCount,fp) == (size_t)c->arcCount;
+    if (fclose(fp) != 0) ok = 0;
+    return ok;
+}
+extern int sizeCSR(CSR * c){
+    if (c == 0) return 0;
+    return c->size;
+}
+extern int64_t arcsCSR(CSR * c){
+    assert(c != 0);
+    return c->arcCount;
+}
+extern int *getCSRids(CSR * c){
+    assert(c != 0);
+    return c->ids;
+}
+extern int64_t *getCSRoffsets(CSR * c){
+    assert(c != 0);
+    return c->offsets;
+}
+extern CSRARC *getCSRarcs(CSR * c){
+    assert(c != 0);
+    return c->arcs;
+}
+extern void freeCSR(CSR * c){
+    assert(c != 0);
+    if (c->mapping != 0){
+        freeMAPPING(c->mapping);
+    }
+    else{
+        free(c->ids);
+        free(c->offsets);
+        free(c->arcs);
+    }
+    free((CSR *)c);
+}
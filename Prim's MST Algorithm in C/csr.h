@@ -0,0 +1,25 @@
+#ifndef __CSR_INCLUDED__
+#define __CSR_INCLUDED__
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef struct csrarc{
+    int vertex;     // index of the neighbor
+    int weight;
+}CSRARC;
+
+typedef struct csr CSR;
+
+extern CSR *newCSR(int vertices,int64_t arcs);
+extern CSR *loadCSR(char *filename);
+extern int isCSRfile(char *filename);
+extern int writeCSR(CSR *c,char *filename);
+extern int sizeCSR(CSR *c);
+extern int64_t arcsCSR(CSR *c);
+extern int *getCSRids(CSR *c);
+extern int64_t *getCSRoffsets(CSR *c);
+extern CSRARC *getCSRarcs(CSR *c);
+extern void freeCSR(CSR *c);
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ *  An indexed d-ary min heap over the dense vertex indices 0..capacity-1.
+ *  The heap is one flat array of (key, vertex) entries and a position
+ *  array gives the slot of every vertex, so decreaseKey finds its entry
+ *  in O(1) and nothing is allocated after construction. Entries move by
+ *  hole shifting, each level costing one copy instead of a swap.
+ *
+ *  Ties on the key are broken on rank[vertex], which prim sets to the
+ *  vertex numbers so the extraction order matches compareVERTEX. With a
+ *  null rank, ties are broken on the index.
+ *
+ *  The arity is fixed at compile time with -DDARY_ARITY=2, 4 or 8.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "dary.h"
+
+#ifndef DARY_ARITY
+#define DARY_ARITY 4
+#endif
+
+#if DARY_ARITY != 2 && DARY_ARITY != 4 && DARY_ARITY != 8
+#error "DARY_ARITY must be 2, 4 or 8"
+#endif
+
+typedef struct daryentry{
+    int key;
+    int vertex;
+}DARYENTRY;
+
+struct dary{
+    DARYENTRY * heap;
+    int * position;     // slot of each vertex, -1 if it is not in the heap
+    int * rank;
+    int size;
+    int capacity;
+};
+
+//Constructor
+extern DARY *newDARY(int capacity,int * rank){
+    DARY * h = malloc(sizeof(DARY));
+    assert(h != 0);
+    h->heap = malloc(sizeof(DARYENTRY) * (capacity + 1));
+    h->position = malloc(sizeof(int) * (capacity + 1));
+    assert(h->heap != 0 && h->position != 0);
+    for (int i = 0; i < capacity; i++){
+        h->position[i] = -1;
+    }
+    h->rank = rank;
+    h->size = 0;
+    h->capacity = capacity;
+    return h;
+}
+
+/// Private helper FUNCTIONS ///
+static int less(DARY * h,DARYENTRY a,DARYENTRY b){
+    if (a.key != b.key) return a.key < b.key;
+    if (h->rank != 0) return h->rank[a.vertex] < h->rank[b.vertex];
+    return a.vertex < b.vertex;
+}
+static void place(DARY * h,int slot,DARYENTRY e){
+    h->heap[slot] = e;
+    h->position[e.vertex] = slot;
+}
+static void siftUp(DARY * h,int slot){
+    DARYENTRY e = h->heap[slot];
+    while (slot > 0){
+        int parent = (slot - 1) / DARY_ARITY;
+        if (!less(h,e,h->heap[parent])) break;
+        place(h,slot,h->heap[parent]);
+        slot = parent;
+    }
+    place(h,slot,e);
+}
+static void siftDown(DARY * h,int slot){
+    DARYENTRY e = h->heap[slot];
+    while (1){
+        int first = slot * DARY_ARITY + 1;
+        if (first >= h->size) break;
+        int last = first + DARY_ARITY;
+        if (last > h->size) last = h->size;
+        int best = first;
+        for (int c = first + 1; c < last; c++){
+            if (less(h,h->heap[c],h->heap[best])) best = c;
+        }
+        if (!less(h,h->heap[best],e)) break;
+        place(h,slot,h->heap[best]);
+        slot = best;
+    }
+    place(h,slot,e);
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void insertDARY(DARY * h,int vertex,int key){
+    assert(h != 0 && vertex >= 0 && vertex < h->capacity);
+    assert(h->position[vertex] == -1);
+    DARYENTRY e = {key,vertex};
+    place(h,h->size,e);
+    h->size++;
+    siftUp(h,h->size - 1);
+}
+// the new key must not be larger than the current one
+extern void decreaseKeyDARY(DARY * h,int vertex,int key){
+    assert(h != 0 && containsDARY(h,vertex));
+    int slot = h->position[vertex];
+    assert(key <= h->heap[slot].key);
+    h->heap[slot].key = key;
+    siftUp(h,slot);
+}
+extern int containsDARY(DARY * h,int vertex){
+    assert(h != 0 && vertex >= 0 && vertex < h->capacity);
+    return h->position[vertex] != -1;
+}
+extern int peekDARY(DARY * h){
+    assert(h != 0 && h->size > 0);
+    return h->heap[0].vertex;
+}
+extern int extractDARY(DARY * h){
+    assert(h != 0 && h->size > 0);
+    int vertex = h->heap[0].vertex;
+    h->position[vertex] = -1;
+    h->size--;
+    if (h->size > 0){
+        place(h,0,h->heap[h->size]);
+        siftDown(h,0);
+    }
+    return vertex;
+}
+extern int sizeDARY(DARY * h){
+    if (h == 0) return 0;
+    return h->size;
+}
+extern int arityDARY(void){
+    return DARY_ARITY;
+}
+extern void displayDARY(DARY * h,FILE * fp){
+    assert(h != 0);
+    if (h->size == 0){
+        fprintf(fp,"EMPTY\n");
+        return;
+    }
+    for (int i = 0; i < h->size; i++){
+        if (i > 0) fprintf(fp," ");
+        fprintf(fp,"%d(%d)",h->heap[i].vertex,h->heap[i].key);
+    }
+    fprintf(fp,"\n");
+}
+extern void freeDARY(DARY * h){
+    assert(h != 0);
+    free(h->heap);
+    free(h->position);
+    free((DARY *)h);
+}
@@ -0,0 +1,19 @@
+#ifndef __DARY_INCLUDED__
+#define __DARY_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct dary DARY;
+
+extern DARY *newDARY(int capacity,int *rank);
+extern void insertDARY(DARY *h,int vertex,int key);
+extern void decreaseKeyDARY(DARY *h,int vertex,int key);
+extern int containsDARY(DARY *h,int vertex);
+extern int peekDARY(DARY *h);
+extern int extractDARY(DARY *h);
+extern int sizeDARY(DARY *h);
+extern int arityDARY(void);
+extern void displayDARY(DARY *h,FILE *fp);
+extern void freeDARY(DARY *h);
+
+#endif
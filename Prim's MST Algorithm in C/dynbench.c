@@ -0,0 +1,292 @@
+/*
+ *  dynbench, how fast the DYNMST takes updates against finding the tree
+ *  again from nothing after each one.
+ *
+ *      dynbench [vertices [edges [updates [random|tree|path]]]]
+ *
+ *  A random graph is made, every vertex joined to an earlier one so the
+ *  graph starts out connected, and built into a DYNMST at once. Then a random mix
+ *  of updates is run through it, a third each of inserting a new edge,
+ *  deleting an edge and giving an edge a new weight, and the time they
+ *  take is measured. Every so often the updates stop and the tree is
+ *  found again from the edges there are at that point, the way prim
+ *  would: the GRAPH is built, packed into a CSR and kruskal run over it.
+ *  That time is measured apart, and the weight it finds has to be the
+ *  weight the DYNMST has.
+ *
+ *  The mode says which edges are deleted. In random mode it is any edge,
+ *  most of them left out of the forest and cheap to drop. In tree mode it
+ *  is an edge of the forest, so every delete is a cut. Path mode also
+ *  cuts tree edges, but the graph starts out as a path of light edges
+ *  and every other weight is heavier, so the forest stays a long path
+ *  that a cut splits into two big sides: the worst case for the
+ *  replacement search.
+ *
+ *  Built and run with  make bench
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include "dynmst.h"
+#include "edgemap.h"
+#include "graph.h"
+#include "csr.h"
+#include "kruskal.h"
+
+#define MAXWEIGHT 1000000
+#define RECOMPUTES 10
+
+typedef struct benchedge{
+    int v1;
+    int v2;
+    int weight;
+}BENCHEDGE;
+
+// the edges there are, with where each one is in the list
+typedef struct benchgraph{
+    BENCHEDGE * edges;
+    long long size;
+    EDGEMAP * positions;
+}BENCHGRAPH;
+
+// the tree edges still to be deleted, in random order
+typedef struct treepick{
+    MSTEDGE * edges;
+    int left;
+}TREEPICK;
+
+static uint64_t state = 88172645463325252ULL;
+
+/// Private helper FUNCTIONS ///
+static uint64_t randomNumber(void){
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+static int randomBelow(long long n){
+    return (int)(randomNumber() % (uint64_t)n);
+}
+static double seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+static void addEdge(BENCHGRAPH * g,int v1,int v2,int weight){
+    g->edges[g->size].v1 = v1;
+    g->edges[g->size].v2 = v2;
+    g->edges[g->size].weight = weight;
+    setEDGEMAP(g->positions,v1,v2,g->size);
+    g->size++;
+}
+static void removeEdge(BENCHGRAPH * g,long long position){
+    BENCHEDGE * e = &g->edges[position];
+    deleteEDGEMAP(g->positions,e->v1,e->v2);
+    g->size--;
+    if (position == g->size) return;
+    *e = g->edges[g->size];
+    setEDGEMAP(g->positions,e->v1,e->v2,position);
+}
+// a weight for an edge off the path, heavier than any on it, in path mode
+static int heavyWeight(int path){
+    return path ? MAXWEIGHT / 2 + randomBelow(MAXWEIGHT / 2) : randomBelow(MAXWEIGHT);
+}
+// a random pair of vertices with no edge yet, 0 if none was found
+static int newPair(BENCHGRAPH * g,int vertices,int * v1,int * v2){
+    for (int tries = 0; tries < 100; tries++){
+        *v1 = randomBelow(vertices);
+        *v2 = randomBelow(vertices);
+        if (*v1 != *v2 && findEDGEMAP(g->positions,*v1,*v2) == -1) return 1;
+    }
+    return 0;
+}
+// where in g a tree edge of d is, taken in turn from a shuffled copy of
+// the forest, or a random edge if the forest has none still in g
+static long long treePosition(BENCHGRAPH * g,DYNMST * d,TREEPICK * pick){
+    for (int refills = 0; refills < 2; refills++){
+        while (pick->left > 0){
+            MSTEDGE * e = &pick->edges[--pick->left];
+            long long position = findEDGEMAP(g->positions,e->v1,e->v2);
+            if (position != -1) return position;
+        }
+        if (refills == 0){
+            pick->left = getDYNMSTedges(d,pick->edges);
+            for (int i = pick->left - 1; i > 0; i--){
+                int j = randomBelow(i + 1);
+                MSTEDGE swap = pick->edges[i];
+                pick->edges[i] = pick->edges[j];
+                pick->edges[j] = swap;
+            }
+        }
+    }
+    return randomBelow(g->size);
+}
+// the edges of g as a CSR on vertices numbered as they are, each edge an
+// arc both ways, for buildDYNMST
+static CSR *packGraph(BENCHGRAPH * g,int vertices){
+    CSR * graph = newCSR(vertices,2 * g->size);
+    int * ids = getCSRids(graph);
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
+    for (int v = 0; v <= vertices; v++){
+        offsets[v] = 0;
+    }
+    for (long long e = 0; e < g->size; e++){
+        offsets[g->edges[e].v1 + 1]++;
+        offsets[g->edges[e].v2 + 1]++;
+    }
+    for (int v = 0; v < vertices; v++){
+        ids[v] = v;
+        offsets[v + 1] += offsets[v];
+    }
+    int64_t * next = malloc(sizeof(int64_t) * (vertices + 1));
+    assert(next != 0);
+    memcpy(next,offsets,sizeof(int64_t) * (vertices + 1));
+    for (long long e = 0; e < g->size; e++){
+        BENCHEDGE * edge = &g->edges[e];
+        arcs[next[edge->v1]].vertex = edge->v2;
+        arcs[next[edge->v1]++].weight = edge->weight;
+        arcs[next[edge->v2]].vertex = edge->v1;
+        arcs[next[edge->v2]++].weight = edge->weight;
+    }
+    free(next);
+    return graph;
+}
+// the weight of the forest found from nothing, as prim's main would
+static long long recompute(BENCHGRAPH * g,int vertices){
+    GRAPH * builder = newGRAPH();
+    for (long long e = 0; e < g->size; e++){
+        insertGRAPHedge(builder,g->edges[e].v1,g->edges[e].v2,g->edges[e].weight);
+    }
+    CSR * graph = getGRAPHcsr(builder);
+    freeGRAPH(builder);
+    MSTEDGE * tree = malloc(sizeof(MSTEDGE) * (vertices + 1));
+    assert(tree != 0);
+    int count = kruskalMST(graph,tree);
+    long long weight = 0;
+    for (int e = 0; e < count; e++){
+        weight += tree[e].weight;
+    }
+    free(tree);
+    freeCSR(graph);
+    return weight;
+}
+
+int
+main(int argc,char **argv){
+    int vertices = (argc > 1) ? atoi(argv[1]) : 100000;
+    long long edges = (argc > 2) ? atoll(argv[2]) : 500000;
+    long long updates = (argc > 3) ? atoll(argv[3]) : 200000;
+    char * mode = (argc > 4) ? argv[4] : "random";
+    int path = strcmp(mode,"path") == 0;
+    int cutting = path || strcmp(mode,"tree") == 0;
+    if (vertices < 2 || edges < vertices - 1 || updates < 1 || (!cutting && strcmp(mode,"random") != 0)){
+        fprintf(stderr,"usage: dynbench [vertices [edges [updates [random|tree|path]]]], edges at least vertices - 1\n");
+        return 1;
+    }
+    BENCHGRAPH g;
+    // every update can add at most one edge
+    g.edges = malloc(sizeof(BENCHEDGE) * (edges + updates + 1));
+    assert(g.edges != 0);
+    g.size = 0;
+    g.positions = newEDGEMAP();
+    int v1 = 0;
+    int v2 = 0;
+    // a path has the lighter half of the weights, so it is the forest
+    for (int v = 1; v < vertices; v++){
+        if (path) addEdge(&g,v - 1,v,randomBelow(MAXWEIGHT / 2));
+        else addEdge(&g,randomBelow(v),v,randomBelow(MAXWEIGHT));
+    }
+    while (g.size < edges && newPair(&g,vertices,&v1,&v2)){
+        addEdge(&g,v1,v2,heavyWeight(path));
+    }
+
+    double started = seconds();
+    DYNMST * d = newDYNMST(vertices);
+    CSR * graph = packGraph(&g,vertices);
+    buildDYNMST(d,graph);
+    freeCSR(graph);
+    double built = seconds() - started;
+    printf("graph: %d vertices, %lld edges, built in %.3fs, %s deletes\n",vertices,g.size,built,mode);
+
+    TREEPICK pick;
+    pick.edges = malloc(sizeof(MSTEDGE) * vertices);
+    assert(pick.edges != 0);
+    pick.left = 0;
+    double dynamic = 0;
+    double times[3] = {0,0,0};
+    long long counts[3] = {0,0,0};
+    long long skipped = 0;
+    double recomputing = 0;
+    int recomputes = 0;
+    long long cuts = 0;
+    long long every = (updates + RECOMPUTES - 1) / RECOMPUTES;
+    for (long long u = 0; u < updates; u++){
+        int kind = randomBelow(3);
+        double took = 0;
+        if (kind == 0){
+            // no new pair is left to join when the graph is nearly complete
+            if (newPair(&g,vertices,&v1,&v2)){
+                int weight = heavyWeight(path);
+                started = seconds();
+                insertDYNMSTedge(d,v1,v2,weight,0);
+                took = seconds() - started;
+                addEdge(&g,v1,v2,weight);
+            }
+            else skipped++;
+        }
+        else if (kind == 1 && g.size > 0){
+            long long position = cutting ? treePosition(&g,d,&pick) : randomBelow(g.size);
+            started = seconds();
+            int result = deleteDYNMSTedge(d,g.edges[position].v1,g.edges[position].v2,0);
+            took = seconds() - started;
+            if (result == DYNMST_SUBSTITUTED || result == DYNMST_SPLIT) cuts++;
+            removeEdge(&g,position);
+        }
+        else if (kind == 2 && g.size > 0){
+            long long position = randomBelow(g.size);
+            int weight = heavyWeight(path);
+            started = seconds();
+            int result = reweightDYNMSTedge(d,g.edges[position].v1,g.edges[position].v2,weight,0);
+            took = seconds() - started;
+            if (result == DYNMST_SUBSTITUTED) cuts++;
+            g.edges[position].weight = weight;
+        }
+        dynamic += took;
+        times[kind] += took;
+        counts[kind]++;
+        if ((u + 1) % every == 0 || u + 1 == updates){
+            started = seconds();
+            long long weight = recompute(&g,vertices);
+            recomputing += seconds() - started;
+            recomputes++;
+            if (weight != weightDYNMST(d)){
+                fprintf(stderr,"after %lld updates the weight is %lld, found again it is %lld\n",u + 1,weightDYNMST(d),weight);
+                return 1;
+            }
+        }
+    }
+    double perRecompute = recomputing / recomputes;
+    printf("dynamic: %lld updates in %.3fs, %.0f updates/s, %lld replaced a tree edge\n",
+           updates,dynamic,updates / dynamic,cuts);
+    char * kinds[3] = {"inserts","deletes","reweights"};
+    for (int k = 0; k < 3; k++){
+        printf("  %s: %lld in %.3fs, %.1fus each",kinds[k],counts[k],times[k],counts[k] ? times[k] / counts[k] * 1e6 : 0);
+        if (k == 0 && skipped) printf(", %lld skipped with no new pair left",skipped);
+        printf("\n");
+    }
+    printf("recomputing: %.3fs a time over %d times, %.1f updates/s\n",perRecompute,recomputes,1 / perRecompute);
+    printf("speedup: %.0fx\n",perRecompute / (dynamic / updates));
+    printf("weight: %lld, checked %d times\n",weightDYNMST(d),recomputes);
+    free(pick.edges);
+    freeDYNMST(d);
+    freeEDGEMAP(g.positions);
+    free(g.edges);
+    return 0;
+}
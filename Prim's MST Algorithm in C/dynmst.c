@@ -0,0 +1,356 @@
+/*
+ *  A minimum spanning forest kept up to date as edges are inserted,
+ *  deleted and reweighted, a DYNMST. The forest is held in LINKCUT trees
+ *  where every tree edge is a node of its own, carrying the weight,
+ *  between the nodes of its two vertices, which carry no weight at all.
+ *  The same forest is also held as a TOUR, Euler tours cut into blocks
+ *  after Frederickson, that holds every edge left out of the forest and
+ *  keeps the lightest one between each two blocks of a tree.
+ *
+ *      insert (v1,v2,w): if v1 and v2 are in different trees the edge
+ *      joins them. Otherwise the heaviest edge on the tree path from v1 to
+ *      v2 is found, and if w is lighter the two change places, the
+ *      heavier edge being left out.
+ *
+ *      delete: an edge that was left out is just dropped. For a tree edge
+ *      the TOUR gives the lightest edge left out that crosses its cut,
+ *      which takes its place.
+ *
+ *      reweight: a left out edge that gets lighter is inserted again, and
+ *      a tree edge that gets heavier is replaced as in a delete, unless
+ *      nothing lighter than its new weight crosses the cut, in which case
+ *      it stays. Anything else only changes the weight.
+ *
+ *  Inserting an edge that is already there reweights it. The weight of
+ *  the forest is kept as it changes, so asking for it is O(1).
+ *
+ *  The LINKCUT trees answer in O(log V) amortized, and the TOUR in
+ *  O(W^(2/3)), W being O(V + E), whenever the forest changes or a tree
+ *  edge is searched across. Holding or dropping an edge left out costs it
+ *  O(1) unless that edge was the lightest between its blocks. No side of
+ *  a cut is ever walked, so however the forest is cut no update is worse
+ *  than O(W^(2/3)), as dynbench path shows.
+ *
+ *  Vertices are numbered 0..V-1, addDYNMSTvertex adding one more.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "dynmst.h"
+#include "linkcut.h"
+#include "edgemap.h"
+#include "tour.h"
+
+// the value of a vertex node, lighter than any edge
+#define VERTEXVALUE INT64_MIN
+
+typedef struct dynedge{
+    int v1;
+    int v2;
+    int weight;
+    int node;       // the LINKCUT node while in the forest, -1 when left out
+    int position;   // in the list of tree edges
+}DynEDGE;
+
+struct dynmst{
+    LINKCUT * forest;
+    TOUR * tours;       // the forest again, holding the edges left out
+    int * vertexNodes;  // the LINKCUT node of each vertex
+    int vertices;
+    int vertexCapacity;
+    int * nodeEdges;    // the edge of each node that is an edge
+    int nodeCapacity;
+    DynEDGE * edges;
+    int edgeSize;       // edges ever made, released ones included
+    int edgeCapacity;
+    int * released;     // edges that can be handed out again
+    int releasedCount;
+    EDGEMAP * ids;      // the edge between two vertices
+    int * tree;         // the tree edges
+    int treeSize;
+    long long count;    // edges in all
+    long long weight;
+};
+
+//Constructor
+extern DYNMST *newDYNMST(int vertices){
+    assert(vertices >= 0);
+    DYNMST * d = malloc(sizeof(DYNMST));
+    assert(d != 0);
+    d->forest = newLINKCUT();
+    d->tours = newTOUR();
+    d->vertices = 0;
+    d->vertexCapacity = vertices + 1;
+    d->vertexNodes = malloc(sizeof(int) * d->vertexCapacity);
+    d->tree = malloc(sizeof(int) * d->vertexCapacity);
+    d->nodeCapacity = 2 * vertices + 1;
+    d->nodeEdges = malloc(sizeof(int) * d->nodeCapacity);
+    d->edgeCapacity = 2 * vertices + 1;
+    d->edges = malloc(sizeof(DynEDGE) * d->edgeCapacity);
+    d->released = malloc(sizeof(int) * d->edgeCapacity);
+    assert(d->vertexNodes != 0 && d->tree != 0);
+    assert(d->nodeEdges != 0 && d->edges != 0 && d->released != 0);
+    d->edgeSize = 0;
+    d->releasedCount = 0;
+    d->ids = newEDGEMAP();
+    d->treeSize = 0;
+    d->count = 0;
+    d->weight = 0;
+    for (int i = 0; i < vertices; i++){
+        addDYNMSTvertex(d);
+    }
+    return d;
+}
+
+/// Private helper FUNCTIONS ///
+// whether edge x comes before the key (weight,id), the order the TOUR keeps
+static int before(DYNMST * d,int x,int weight,int id){
+    DynEDGE * e = &d->edges[x];
+    if (e->weight != weight) return e->weight < weight;
+    return x < id;
+}
+static int newEdge(DYNMST * d,int v1,int v2,int weight){
+    int x;
+    if (d->releasedCount > 0) x = d->released[--d->releasedCount];
+    else{
+        if (d->edgeSize == d->edgeCapacity){
+            d->edgeCapacity *= 2;
+            d->edges = realloc(d->edges,sizeof(DynEDGE) * d->edgeCapacity);
+            d->released = realloc(d->released,sizeof(int) * d->edgeCapacity);
+            assert(d->edges != 0 && d->released != 0);
+        }
+        x = d->edgeSize++;
+    }
+    d->edges[x].v1 = v1;
+    d->edges[x].v2 = v2;
+    d->edges[x].weight = weight;
+    d->edges[x].node = -1;
+    setEDGEMAP(d->ids,v1,v2,x);
+    d->count++;
+    return x;
+}
+static void releaseEdge(DYNMST * d,int x){
+    DynEDGE * e = &d->edges[x];
+    deleteEDGEMAP(d->ids,e->v1,e->v2);
+    d->released[d->releasedCount++] = x;
+    d->count--;
+}
+static void linkEdge(DYNMST * d,int x){
+    DynEDGE * e = &d->edges[x];
+    int node = newLINKCUTnode(d->forest,e->weight);
+    if (node >= d->nodeCapacity){
+        d->nodeCapacity = 2 * (node + 1);
+        d->nodeEdges = realloc(d->nodeEdges,sizeof(int) * d->nodeCapacity);
+        assert(d->nodeEdges != 0);
+    }
+    d->nodeEdges[node] = x;
+    e->node = node;
+    e->position = d->treeSize;
+    // a forest has fewer edges than vertices, so the list has room
+    d->tree[d->treeSize++] = x;
+    linkLINKCUT(d->forest,d->vertexNodes[e->v1],node);
+    linkLINKCUT(d->forest,node,d->vertexNodes[e->v2]);
+    d->weight += e->weight;
+}
+static void cutEdge(DYNMST * d,int x){
+    DynEDGE * e = &d->edges[x];
+    cutLINKCUT(d->forest,d->vertexNodes[e->v1],e->node);
+    cutLINKCUT(d->forest,e->node,d->vertexNodes[e->v2]);
+    freeLINKCUTnode(d->forest,e->node);
+    e->node = -1;
+    // the last tree edge takes the place of the one cut
+    int last = d->tree[--d->treeSize];
+    d->tree[e->position] = last;
+    d->edges[last].position = e->position;
+    d->weight -= e->weight;
+}
+static void leaveOut(DYNMST * d,int x){
+    DynEDGE * e = &d->edges[x];
+    insertTOURedge(d->tours,x,e->v1,e->v2,e->weight);
+}
+static void copyEdge(DYNMST * d,int x,MSTEDGE * other){
+    if (other == 0) return;
+    other->v1 = d->edges[x].v1;
+    other->v2 = d->edges[x].v2;
+    other->weight = d->edges[x].weight;
+}
+// puts an edge that is in neither the forest nor the TOUR into the
+// forest if it belongs there, and leaves it out otherwise
+static int placeEdge(DYNMST * d,int x,MSTEDGE * other){
+    DynEDGE * e = &d->edges[x];
+    int n1 = d->vertexNodes[e->v1];
+    int n2 = d->vertexNodes[e->v2];
+    if (!connectedLINKCUT(d->forest,n1,n2)){
+        linkEdge(d,x);
+        linkTOUR(d->tours,x,e->v1,e->v2);
+        return DYNMST_JOINED;
+    }
+    int heaviest = d->nodeEdges[maxLINKCUT(d->forest,n1,n2)];
+    if (d->edges[heaviest].weight <= e->weight){
+        leaveOut(d,x);
+        return DYNMST_UNCHANGED;
+    }
+    copyEdge(d,heaviest,other);
+    cutEdge(d,heaviest);
+    linkEdge(d,x);
+    swapTOUR(d->tours,heaviest,x,e->v1,e->v2);
+    leaveOut(d,heaviest);
+    return DYNMST_REPLACED;
+}
+// puts the left out edge found in the place of tree edge x, already cut
+static void replaceEdge(DYNMST * d,int x,int found,MSTEDGE * other){
+    DynEDGE * e = &d->edges[found];
+    deleteTOURedge(d->tours,found);
+    swapTOUR(d->tours,x,found,e->v1,e->v2);
+    linkEdge(d,found);
+    copyEdge(d,found,other);
+}
+
+///// PUBLIC FUNCTIONS ////
+// fills a DYNMST that has no edges yet with a graph on its vertices
+extern void buildDYNMST(DYNMST * d,CSR * graph){
+    assert(d->count == 0 && sizeCSR(graph) <= d->vertices);
+    // with the forest in first, every other edge is simply left out
+    MSTEDGE * tree = malloc(sizeof(MSTEDGE) * (sizeCSR(graph) + 1));
+    int * ids = malloc(sizeof(int) * (sizeCSR(graph) + 1));
+    int * v1 = malloc(sizeof(int) * (sizeCSR(graph) + 1));
+    int * v2 = malloc(sizeof(int) * (sizeCSR(graph) + 1));
+    assert(tree != 0 && ids != 0 && v1 != 0 && v2 != 0);
+    int count = kruskalMST(graph,tree);
+    for (int e = 0; e < count; e++){
+        ids[e] = newEdge(d,tree[e].v1,tree[e].v2,tree[e].weight);
+        v1[e] = tree[e].v1;
+        v2[e] = tree[e].v2;
+        linkEdge(d,ids[e]);
+    }
+    linkTOURforest(d->tours,count,ids,v1,v2);
+    free(tree);
+    free(ids);
+    free(v1);
+    free(v2);
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
+    for (int u = 0; u < sizeCSR(graph); u++){
+        for (int64_t a = offsets[u]; a < offsets[u + 1]; a++){
+            int v = arcs[a].vertex;
+            if (v > u && findEDGEMAP(d->ids,u,v) == -1) leaveOut(d,newEdge(d,u,v,arcs[a].weight));
+        }
+    }
+}
+// returns the number of the new vertex
+extern int addDYNMSTvertex(DYNMST * d){
+    if (d->vertices == d->vertexCapacity){
+        d->vertexCapacity *= 2;
+        d->vertexNodes = realloc(d->vertexNodes,sizeof(int) * d->vertexCapacity);
+        d->tree = realloc(d->tree,sizeof(int) * d->vertexCapacity);
+        assert(d->vertexNodes != 0 && d->tree != 0);
+    }
+    int node = newLINKCUTnode(d->forest,VERTEXVALUE);
+    if (node >= d->nodeCapacity){
+        d->nodeCapacity = 2 * (node + 1);
+        d->nodeEdges = realloc(d->nodeEdges,sizeof(int) * d->nodeCapacity);
+        assert(d->nodeEdges != 0);
+    }
+    d->nodeEdges[node] = -1;
+    d->vertexNodes[d->vertices] = node;
+    addTOURvertex(d->tours);
+    return d->vertices++;
+}
+extern int sizeDYNMST(DYNMST * d){
+    assert(d != 0);
+    return d->vertices;
+}
+// each of the update functions returns what it did to the forest, filling
+// other, when it is not 0, with the edge that went in or came out
+extern int insertDYNMSTedge(DYNMST * d,int v1,int v2,int weight,MSTEDGE * other){
+    assert(v1 >= 0 && v1 < d->vertices && v2 >= 0 && v2 < d->vertices);
+    if (v1 == v2) return DYNMST_UNCHANGED;
+    if (findEDGEMAP(d->ids,v1,v2) != -1) return reweightDYNMSTedge(d,v1,v2,weight,other);
+    return placeEdge(d,newEdge(d,v1,v2,weight),other);
+}
+extern int deleteDYNMSTedge(DYNMST * d,int v1,int v2,MSTEDGE * other){
+    assert(v1 >= 0 && v1 < d->vertices && v2 >= 0 && v2 < d->vertices);
+    int x = findEDGEMAP(d->ids,v1,v2);
+    if (x == -1) return DYNMST_MISSING;
+    int result = DYNMST_UNCHANGED;
+    if (d->edges[x].node == -1) deleteTOURedge(d->tours,x);
+    else{
+        int found = crossingTOUR(d->tours,x);
+        cutEdge(d,x);
+        if (found == -1){
+            cutTOUR(d->tours,x);
+            result = DYNMST_SPLIT;
+        }
+        else{
+            replaceEdge(d,x,found,other);
+            result = DYNMST_SUBSTITUTED;
+        }
+    }
+    releaseEdge(d,x);
+    return result;
+}
+extern int reweightDYNMSTedge(DYNMST * d,int v1,int v2,int weight,MSTEDGE * other){
+    assert(v1 >= 0 && v1 < d->vertices && v2 >= 0 && v2 < d->vertices);
+    int x = findEDGEMAP(d->ids,v1,v2);
+    if (x == -1) return DYNMST_MISSING;
+    DynEDGE * e = &d->edges[x];
+    int old = e->weight;
+    if (weight == old) return DYNMST_UNCHANGED;
+    if (e->node == -1){
+        deleteTOURedge(d->tours,x);
+        e->weight = weight;
+        if (weight > old){
+            leaveOut(d,x);
+            return DYNMST_UNCHANGED;
+        }
+        return placeEdge(d,x,other);
+    }
+    // a lighter tree edge stays, a heavier one only if nothing crosses below it
+    int found = (weight < old) ? -1 : crossingTOUR(d->tours,x);
+    cutEdge(d,x);
+    e->weight = weight;
+    if (found == -1 || !before(d,found,weight,x)){
+        linkEdge(d,x);
+        return DYNMST_UNCHANGED;
+    }
+    replaceEdge(d,x,found,other);
+    leaveOut(d,x);
+    return DYNMST_SUBSTITUTED;
+}
+extern long long weightDYNMST(DYNMST * d){
+    assert(d != 0);
+    return d->weight;
+}
+extern int edgesDYNMST(DYNMST * d){
+    assert(d != 0);
+    return d->treeSize;
+}
+// the edges in the forest or left out of it
+extern long long countDYNMSTedges(DYNMST * d){
+    assert(d != 0);
+    return d->count;
+}
+// fills tree with the edges of the forest and returns how many
+extern int getDYNMSTedges(DYNMST * d,MSTEDGE * tree){
+    for (int i = 0; i < d->treeSize; i++){
+        DynEDGE * edge = &d->edges[d->tree[i]];
+        tree[i].v1 = edge->v1;
+        tree[i].v2 = edge->v2;
+        tree[i].weight = edge->weight;
+    }
+    return d->treeSize;
+}
+extern void freeDYNMST(DYNMST * d){
+    assert(d != 0);
+    freeLINKCUT(d->forest);
+    freeTOUR(d->tours);
+    freeEDGEMAP(d->ids);
+    free(d->vertexNodes);
+    free(d->tree);
+    free(d->nodeEdges);
+    free(d->edges);
+    free(d->released);
+    free((DYNMST *)d);
+}
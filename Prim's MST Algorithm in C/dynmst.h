@@ -0,0 +1,32 @@
+#ifndef __DYNMST_INCLUDED__
+#define __DYNMST_INCLUDED__
+
+#include <stdio.h>
+#include "kruskal.h"
+
+typedef struct dynmst DYNMST;
+
+// what an update did to the edges of the forest
+enum {
+    DYNMST_UNCHANGED,   // the forest has the same edges
+    DYNMST_JOINED,      // the edge went in, joining two trees
+    DYNMST_REPLACED,    // the edge went in and other came out
+    DYNMST_SUBSTITUTED, // the edge came out and other went in
+    DYNMST_SPLIT,       // the edge came out and nothing could take its place
+    DYNMST_MISSING      // there is no such edge
+};
+
+extern DYNMST *newDYNMST(int vertices);
+extern void buildDYNMST(DYNMST *d,CSR *graph);
+extern int addDYNMSTvertex(DYNMST *d);
+extern int sizeDYNMST(DYNMST *d);
+extern int insertDYNMSTedge(DYNMST *d,int v1,int v2,int weight,MSTEDGE *other);
+extern int deleteDYNMSTedge(DYNMST *d,int v1,int v2,MSTEDGE *other);
+extern int reweightDYNMSTedge(DYNMST *d,int v1,int v2,int weight,MSTEDGE *other);
+extern long long weightDYNMST(DYNMST *d);
+extern int edgesDYNMST(DYNMST *d);
+extern long long countDYNMSTedges(DYNMST *d);
+extern int getDYNMSTedges(DYNMST *d,MSTEDGE *tree);
+extern void freeDYNMST(DYNMST *d);
+
+#endif
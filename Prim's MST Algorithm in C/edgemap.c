@@ -0,0 +1,136 @@
+/*
+ *  An EDGEMAP maps undirected edges, given by two vertex indices, onto
+ *  non-negative ints. It is the EDGESET table with a value beside every
+ *  key: the (smaller,larger) pair packed into 64 bits, open addressing
+ *  with linear probing, doubling when half full. Deleting shifts the rest
+ *  of the probe run back, so no tombstones are left behind.
+ *
+ *  Vertex indices are never negative, so no key collides with EMPTY.
+ *  findEDGEMAP and deleteEDGEMAP return -1 for an edge that is not there.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "edgemap.h"
+
+#define EMPTY UINT64_MAX
+
+typedef struct edgemapslot{
+    uint64_t key;
+    int value;
+}EdgemapSLOT;
+
+struct edgemap{
+    EdgemapSLOT * slots;
+    uint64_t mask;      // capacity - 1, the capacity being a power of 2
+    long long size;
+};
+
+/// Private helper FUNCTIONS ///
+static uint64_t packEdge(int v1,int v2){
+    assert(v1 >= 0 && v2 >= 0);
+    if (v1 > v2){
+        int temp = v1;
+        v1 = v2;
+        v2 = temp;
+    }
+    return ((uint64_t)(uint32_t)v1 << 32) | (uint32_t)v2;
+}
+static uint64_t hashKey(uint64_t x){
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+static EdgemapSLOT *allocateSlots(uint64_t capacity){
+    EdgemapSLOT * slots = malloc(sizeof(EdgemapSLOT) * capacity);
+    assert(slots != 0);
+    for (uint64_t i = 0; i < capacity; i++){
+        slots[i].key = EMPTY;
+    }
+    return slots;
+}
+static uint64_t findSlot(EDGEMAP * m,uint64_t key){
+    uint64_t slot = hashKey(key) & m->mask;
+    while (m->slots[slot].key != EMPTY && m->slots[slot].key != key){
+        slot = (slot + 1) & m->mask;
+    }
+    return slot;
+}
+static void grow(EDGEMAP * m){
+    EdgemapSLOT * old = m->slots;
+    uint64_t oldCapacity = m->mask + 1;
+    m->mask = oldCapacity * 2 - 1;
+    m->slots = allocateSlots(m->mask + 1);
+    for (uint64_t i = 0; i < oldCapacity; i++){
+        if (old[i].key == EMPTY) continue;
+        m->slots[findSlot(m,old[i].key)] = old[i];
+    }
+    free(old);
+}
+
+//Constructor
+extern EDGEMAP *newEDGEMAP(void){
+    EDGEMAP * m = malloc(sizeof(EDGEMAP));
+    assert(m != 0);
+    m->mask = 1024 - 1;
+    m->slots = allocateSlots(m->mask + 1);
+    m->size = 0;
+    return m;
+}
+
+///// PUBLIC FUNCTIONS ////
+// adds the edge or replaces its value
+extern void setEDGEMAP(EDGEMAP * m,int v1,int v2,int value){
+    assert(m != 0 && value >= 0);
+    uint64_t key = packEdge(v1,v2);
+    uint64_t slot = findSlot(m,key);
+    if (m->slots[slot].key == key){
+        m->slots[slot].value = value;
+        return;
+    }
+    m->slots[slot].key = key;
+    m->slots[slot].value = value;
+    m->size++;
+    if ((uint64_t)m->size * 2 > m->mask + 1) grow(m);
+}
+extern int findEDGEMAP(EDGEMAP * m,int v1,int v2){
+    assert(m != 0);
+    uint64_t slot = findSlot(m,packEdge(v1,v2));
+    if (m->slots[slot].key == EMPTY) return -1;
+    return m->slots[slot].value;
+}
+// returns the value the edge had
+extern int deleteEDGEMAP(EDGEMAP * m,int v1,int v2){
+    assert(m != 0);
+    uint64_t hole = findSlot(m,packEdge(v1,v2));
+    if (m->slots[hole].key == EMPTY) return -1;
+    int value = m->slots[hole].value;
+    // pulls back every later key of the run that may sit in the hole
+    uint64_t slot = hole;
+    while (1){
+        slot = (slot + 1) & m->mask;
+        if (m->slots[slot].key == EMPTY) break;
+        uint64_t home = hashKey(m->slots[slot].key) & m->mask;
+        // the key stays if its home lies cyclically in (hole,slot]
+        if (((slot - home) & m->mask) < ((slot - hole) & m->mask)) continue;
+        m->slots[hole] = m->slots[slot];
+        hole = slot;
+    }
+    m->slots[hole].key = EMPTY;
+    m->size--;
+    return value;
+}
+extern long long sizeEDGEMAP(EDGEMAP * m){
+    if (m == 0) return 0;
+    return m->size;
+}
+extern void freeEDGEMAP(EDGEMAP * m){
+    assert(m != 0);
+    free(m->slots);
+    free((EDGEMAP *)m);
+}
@@ -0,0 +1,15 @@
+#ifndef __EDGEMAP_INCLUDED__
+#define __EDGEMAP_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct edgemap EDGEMAP;
+
+extern EDGEMAP *newEDGEMAP(void);
+extern void setEDGEMAP(EDGEMAP *m,int v1,int v2,int value);
+extern int findEDGEMAP(EDGEMAP *m,int v1,int v2);
+extern int deleteEDGEMAP(EDGEMAP *m,int v1,int v2);
+extern long long sizeEDGEMAP(EDGEMAP *m);
+extern void freeEDGEMAP(EDGEMAP *m);
+
+#endif
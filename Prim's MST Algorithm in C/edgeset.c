@@ -0,0 +1,128 @@
+/*
+ *  An EDGESET remembers which undirected edges have been seen. Each edge
+ *  is keyed on its (smaller,larger) vertex pair packed into 64 bits and
+ *  kept in an open addressing table with linear probing, so nothing is
+ *  allocated per edge. The table doubles when it becomes half full.
+ *
+ *  insertEDGESET returns 1 if the edge is new and 0 if it was already
+ *  there, the first occurrence of an edge is the one that is kept.
+ *
+ *  shardEDGESET spreads edges over several EDGESETs, so that each can be
+ *  filled on its own thread. It takes the high half of the same hash,
+ *  the tables probing from the low half, so a shard still fills its
+ *  whole table evenly.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "edgeset.h"
+
+#define EMPTY UINT64_MAX
+
+struct edgeset{
+    uint64_t * slots;
+    uint64_t mask;      // capacity - 1, the capacity being a power of 2
+    long long size;
+    int hasEmptyKey;    // the one edge whose key collides with EMPTY
+};
+
+/// Private helper FUNCTIONS ///
+static uint64_t packEdge(int v1,int v2){
+    if (v1 > v2){
+        int temp = v1;
+        v1 = v2;
+        v2 = temp;
+    }
+    return ((uint64_t)(uint32_t)v1 << 32) | (uint32_t)v2;
+}
+static uint64_t hashKey(uint64_t x){
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+static uint64_t *allocateSlots(uint64_t capacity){
+    uint64_t * slots = malloc(sizeof(uint64_t) * capacity);
+    assert(slots != 0);
+    for (uint64_t i = 0; i < capacity; i++){
+        slots[i] = EMPTY;
+    }
+    return slots;
+}
+static void grow(EDGESET * s){
+    uint64_t * old = s->slots;
+    uint64_t oldCapacity = s->mask + 1;
+    s->mask = oldCapacity * 2 - 1;
+    s->slots = allocateSlots(s->mask + 1);
+    for (uint64_t i = 0; i < oldCapacity; i++){
+        if (old[i] == EMPTY) continue;
+        uint64_t slot = hashKey(old[i]) & s->mask;
+        while (s->slots[slot] != EMPTY){
+            slot = (slot + 1) & s->mask;
+        }
+        s->slots[slot] = old[i];
+    }
+    free(old);
+}
+
+//Constructor
+extern EDGESET *newEDGESET(void){
+    EDGESET * s = malloc(sizeof(EDGESET));
+    assert(s != 0);
+    s->mask = 1024 - 1;
+    s->slots = allocateSlots(s->mask + 1);
+    s->size = 0;
+    s->hasEmptyKey = 0;
+    return s;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int insertEDGESET(EDGESET * s,int v1,int v2){
+    assert(s != 0);
+    uint64_t key = packEdge(v1,v2);
+    if (key == EMPTY){
+        if (s->hasEmptyKey) return 0;
+        s->hasEmptyKey = 1;
+        s->size++;
+        return 1;
+    }
+    uint64_t slot = hashKey(key) & s->mask;
+    while (s->slots[slot] != EMPTY){
+        if (s->slots[slot] == key) return 0;
+        slot = (slot + 1) & s->mask;
+    }
+    s->slots[slot] = key;
+    s->size++;
+    if ((uint64_t)s->size * 2 > s->mask + 1) grow(s);
+    return 1;
+}
+extern int findEDGESET(EDGESET * s,int v1,int v2){
+    assert(s != 0);
+    uint64_t key = packEdge(v1,v2);
+    if (key == EMPTY) return s->hasEmptyKey;
+    uint64_t slot = hashKey(key) & s->mask;
+    while (s->slots[slot] != EMPTY){
+        if (s->slots[slot] == key) return 1;
+        slot = (slot + 1) & s->mask;
+    }
+    return 0;
+}
+// which of shards EDGESETs the edge (v1,v2) belongs in, either way round
+extern int shardEDGESET(int v1,int v2,int shards){
+    assert(shards > 0);
+    uint64_t high = hashKey(packEdge(v1,v2)) >> 32;
+    return (int)((high * (uint64_t)shards) >> 32);
+}
+extern long long sizeEDGESET(EDGESET * s){
+    if (s == 0) return 0;
+    return s->size;
+}
+extern void freeEDGESET(EDGESET * s){
+    assert(s != 0);
+    free(s->slots);
+    free((EDGESET *)s);
+}
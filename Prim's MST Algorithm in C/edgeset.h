@@ -0,0 +1,15 @@
+#ifndef __EDGESET_INCLUDED__
+#define __EDGESET_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct edgeset EDGESET;
+
+extern EDGESET *newEDGESET(void);
+extern int insertEDGESET(EDGESET *s,int v1,int v2);
+extern int findEDGESET(EDGESET *s,int v1,int v2);
+extern int shardEDGESET(int v1,int v2,int shards);
+extern long long sizeEDGESET(EDGESET *s);
+extern void freeEDGESET(EDGESET *s);
+
+#endif
@@ -0,0 +1,287 @@
+/*
+ *  A generic FIBONACCI heap class. When constructed takes function pointers
+ *  to display, compare, update, and free the generic value stored in the
+ *  heap, the same shape as the BINOMIAL heap so either can be handed to prim.
+ *
+ *  Roots and siblings are kept in circular doubly linked rings inside the
+ *  nodes. Insert and union only splice rings, consolidation is put off
+ *  until an extract, and decreaseKey cuts the node loose and cascades the
+ *  cuts up through marked parents, so decreaseKey is O(1) amortized and
+ *  extract O(log n) amortized.
+ *
+ *  A node holds on to its value for its whole life, values are never
+ *  swapped between nodes, so the update function is never needed here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "fibonacci.h"
+
+// a degree can not reach 64 before the size overflows an int
+#define MAXDEGREE 64
+
+typedef struct fibonaccinode{
+    void * data;
+    int degree;
+    int mark;       // lost a child since it last became a child itself
+    struct fibonaccinode * parent;
+    struct fibonaccinode * child;   // any one of the children
+    struct fibonaccinode * left;    // siblings, or roots, form a ring
+    struct fibonaccinode * right;
+}FibonacciNODE;
+
+struct fibonacci{
+    void (*display)(void *,FILE *);
+    int (*compare)(void *,void *);
+    void (*update)(void *,void *);
+    void (*free)(void *);
+    FibonacciNODE * extreme;        // also the way into the root ring
+    FibonacciNODE * degrees[MAXDEGREE];   // used while consolidating
+    int size;
+    int roots;
+};
+
+//Constructor
+extern FIBONACCI *newFIBONACCI(void (*d)(void *,FILE *),int (*c)(void *,void *),void (*s)(void *,void *),void (*f)(void *)){
+    FIBONACCI * created = malloc(sizeof(FIBONACCI));
+    assert(created != 0);
+    created->display = d;
+    created->compare = c;
+    created->update = s;
+    created->free = f;
+    created->extreme = 0;
+    for (int i = 0; i < MAXDEGREE; i++){
+        created->degrees[i] = 0;
+    }
+    created->size = 0;
+    created->roots = 0;
+    return created;
+}
+
+//// Private ring FUNCTIONS ////
+// joins the ring holding b into the ring holding a
+static void spliceRing(FibonacciNODE * a,FibonacciNODE * b){
+    FibonacciNODE * aRight = a->right;
+    FibonacciNODE * bLeft = b->left;
+    a->right = b;
+    b->left = a;
+    bLeft->right = aRight;
+    aRight->left = bLeft;
+}
+static void removeFromRing(FibonacciNODE * n){
+    n->left->right = n->right;
+    n->right->left = n->left;
+    n->left = n;
+    n->right = n;
+}
+static FibonacciNODE *newFibonacciNODE(void * value){
+    FibonacciNODE * n = malloc(sizeof(FibonacciNODE));
+    assert(n != 0);
+    n->data = value;
+    n->degree = 0;
+    n->mark = 0;
+    n->parent = 0;
+    n->child = 0;
+    n->left = n;
+    n->right = n;
+    return n;
+}
+
+///// Private helper FUNCTIONS /////
+static void addRoot(FIBONACCI * f,FibonacciNODE * n){
+    n->parent = 0;
+    n->mark = 0;
+    if (f->extreme == 0) f->extreme = n;
+    else spliceRing(f->extreme,n);
+    f->roots++;
+}
+// makes y a child of x, y having been a root
+static void link(FIBONACCI * f,FibonacciNODE * y,FibonacciNODE * x){
+    removeFromRing(y);
+    f->roots--;
+    y->parent = x;
+    y->mark = 0;
+    if (x->child == 0) x->child = y;
+    else spliceRing(x->child,y);
+    x->degree++;
+}
+static void cut(FIBONACCI * f,FibonacciNODE * x,FibonacciNODE * p){
+    if (p->child == x) p->child = (x->right == x) ? 0 : x->right;
+    removeFromRing(x);
+    p->degree--;
+    addRoot(f,x);
+}
+static void cascadingCut(FIBONACCI * f,FibonacciNODE * y){
+    FibonacciNODE * z = y->parent;
+    while (z != 0){
+        if (y->mark == 0){
+            y->mark = 1;
+            return;
+        }
+        cut(f,y,z);
+        y = z;
+        z = y->parent;
+    }
+}
+static void consolidate(FIBONACCI * f){
+    int n = f->roots;
+    FibonacciNODE * w = f->extreme;
+    for (int i = 0; i < n; i++){
+        FibonacciNODE * next = w->right;
+        FibonacciNODE * x = w;
+        int d = x->degree;
+        while (f->degrees[d] != 0){
+            FibonacciNODE * y = f->degrees[d];
+            if (f->compare(y->data,x->data) < 0){
+                FibonacciNODE * temp = x;
+                x = y;
+                y = temp;
+            }
+            link(f,y,x);
+            f->degrees[d] = 0;
+            d++;
+        }
+        f->degrees[d] = x;
+        w = next;
+    }
+    // the roots left are exactly the ones in the degree table
+    f->extreme = 0;
+    for (int d = 0; d < MAXDEGREE; d++){
+        FibonacciNODE * x = f->degrees[d];
+        if (x == 0) continue;
+        f->degrees[d] = 0;
+        if (f->extreme == 0 || f->compare(x->data,f->extreme->data) < 0) f->extreme = x;
+    }
+}
+static void *removeExtreme(FIBONACCI * f){
+    FibonacciNODE * z = f->extreme;
+    assert(z != 0);
+    // the children of z become roots
+    FibonacciNODE * child = z->child;
+    if (child != 0){
+        FibonacciNODE * c = child;
+        do{
+            c->parent = 0;
+            c->mark = 0;
+            c = c->right;
+        }while (c != child);
+        spliceRing(z,child);
+        f->roots += z->degree;
+    }
+    FibonacciNODE * next = z->right;
+    removeFromRing(z);
+    f->roots--;
+    f->size--;
+    if (next == z){
+        f->extreme = 0;
+    }
+    else{
+        f->extreme = next;
+        consolidate(f);
+    }
+    void * generic = z->data;
+    free((FibonacciNODE *)z);
+    return generic;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void *insertFIBONACCI(FIBONACCI * f,void * value){
+    FibonacciNODE * n = newFibonacciNODE(value);
+    addRoot(f,n);
+    if (f->compare(value,f->extreme->data) < 0) f->extreme = n;
+    f->size++;
+    return n;
+}
+extern int sizeFIBONACCI(FIBONACCI * f){
+    if (f == 0) return 0;
+    return f->size;
+}
+extern void unionFIBONACCI(FIBONACCI * f,FIBONACCI * donor){
+    //f and donor are fibonacci heaps
+    if (donor->extreme == 0) return;
+    if (f->extreme == 0){
+        f->extreme = donor->extreme;
+    }
+    else{
+        spliceRing(f->extreme,donor->extreme);
+        if (f->compare(donor->extreme->data,f->extreme->data) < 0) f->extreme = donor->extreme;
+    }
+    f->size += donor->size;
+    f->roots += donor->roots;
+    donor->extreme = 0;
+    donor->size = 0;
+    donor->roots = 0;
+}
+// the value is removed from the heap but not freed
+extern void deleteFIBONACCI(FIBONACCI * f,void * node){
+    assert(node != 0);
+    FibonacciNODE * n = node;
+    FibonacciNODE * p = n->parent;
+    if (p != 0){
+        cut(f,n,p);
+        cascadingCut(f,p);
+    }
+    f->extreme = n;
+    removeExtreme(f);
+}
+extern void decreaseKeyFIBONACCI(FIBONACCI * f,void * node,void * value){
+    assert(node != 0);
+    FibonacciNODE * n = node;
+    n->data = value;
+    FibonacciNODE * p = n->parent;
+    if (p != 0 && f->compare(n->data,p->data) < 0){
+        cut(f,n,p);
+        cascadingCut(f,p);
+    }
+    if (f->compare(n->data,f->extreme->data) < 0) f->extreme = n;
+}
+extern void *peekFIBONACCI(FIBONACCI * f){
+    assert(f != 0 && f->extreme != 0);
+    return f->extreme->data;
+}
+extern void *extractFIBONACCI(FIBONACCI * f){
+    assert(f != 0);
+    if (f->extreme == 0) return 0;
+    return removeExtreme(f);
+}
+extern void statisticsFIBONACCI(FIBONACCI * f,FILE * fp){
+    fprintf(fp,"size: %d\n",f->size);
+    fprintf(fp,"rootlist size: %d\n",f->roots);
+    fprintf(fp,"extreme: ");
+    if (f->extreme != 0) f->display(f->extreme->data,fp);
+    else fprintf(fp,"NULL");
+}
+extern void displayFIBONACCI(FIBONACCI * f,FILE * fp){
+    if (f->size == 0){
+        fprintf(fp,"EMPTY\n");
+        return;
+    }
+    fprintf(fp,"rootlist: ");
+    FibonacciNODE * ptr = f->extreme;
+    do{
+        f->display(ptr->data,fp);
+        fprintf(fp,"[%d]",ptr->degree);
+        if (ptr == f->extreme) fprintf(fp,"*");
+        ptr = ptr->right;
+        if (ptr != f->extreme) fprintf(fp," ");
+    }while (ptr != f->extreme);
+    fprintf(fp,"\n");
+}
+extern void freeFIBONACCI(FIBONACCI * f){
+    assert(f != 0);
+    // children are spliced into the root ring as their parents are freed
+    FibonacciNODE * ptr = f->extreme;
+    while (ptr != 0){
+        if (ptr->child != 0){
+            spliceRing(ptr,ptr->child);
+            ptr->child = 0;
+        }
+        FibonacciNODE * next = (ptr->right == ptr) ? 0 : ptr->right;
+        removeFromRing(ptr);
+        if (f->free != 0 && ptr->data != 0) f->free(ptr->data);
+        free((FibonacciNODE *)ptr);
+        ptr = next;
+    }
+    free((FIBONACCI *)f);
+}
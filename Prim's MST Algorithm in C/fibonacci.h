@@ -0,0 +1,24 @@
+#ifndef __FIBONACCI_INCLUDED__
+#define __FIBONACCI_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct fibonacci FIBONACCI;
+
+extern FIBONACCI *newFIBONACCI(
+        void (*display)(void *,FILE *),
+        int (*compare)(void *,void *),
+        void (*update)(void *,void *),
+        void (*free)(void *));
+extern void *insertFIBONACCI(FIBONACCI *f,void *value);
+extern int sizeFIBONACCI(FIBONACCI *f);
+extern void unionFIBONACCI(FIBONACCI *,FIBONACCI *);
+extern void deleteFIBONACCI(FIBONACCI *f,void *node);
+extern void decreaseKeyFIBONACCI(FIBONACCI *f,void *node,void *value);
+extern void *peekFIBONACCI(FIBONACCI *f);
+extern void *extractFIBONACCI(FIBONACCI *f);
+extern void statisticsFIBONACCI(FIBONACCI *f,FILE *fp);
+extern void displayFIBONACCI(FIBONACCI *f,FILE *fp);
+extern void freeFIBONACCI(FIBONACCI *f);
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ *  The GRAPH builder. Edges are handed in one at a time as they are read
+ *  and the builder drops duplicate edges, numbers each vertex the first
+ *  time it is seen and records every new edge in a flat edge list.
+ *
+ *  Vertices are numbered in the order they were first seen, the very
+ *  first one being the source vertex for prim. Once everything has been
+ *  read, getGRAPHcsr packs the edge list into a CSR for the algorithms,
+ *  each vertex listing its arcs in the order the edges were read.
+ *
+ *  A reader with several threads can build the same GRAPH in steps
+ *  instead. shardGRAPH spreads the duplicate check over several EDGESETs
+ *  so keepGRAPHedge can run on a thread per shard. The vertices are
+ *  numbered with addGRAPHvertex in the order they were first seen, and
+ *  the edges kept are put in with extendGRAPH and setGRAPHedge, which
+ *  only looks numbers up and so can run on many threads at once.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "graph.h"
+#include "edgeset.h"
+#include "intern.h"
+
+typedef struct graphedge{
+    int v1;     // indices of the endpoints
+    int v2;
+    int weight;
+}GRAPHEDGE;
+
+struct graph{
+    EDGESET ** edges;       // to determine duplicate edges, one per shard
+    int shards;
+    INTERN * numbers;       // vertex number to index, to determine duplicate vertices
+    GRAPHEDGE * list;       // the edges kept, loops excluded
+    int64_t size;
+    int64_t capacity;
+};
+
+extern GRAPH *newGRAPH(void){
+    GRAPH * g = malloc(sizeof(GRAPH));
+    assert(g != 0);
+    g->shards = 1;
+    g->edges = malloc(sizeof(EDGESET *));
+    assert(g->edges != 0);
+    g->edges[0] = newEDGESET();
+    g->numbers = newINTERN();
+    g->capacity = 1024;
+    g->size = 0;
+    g->list = malloc(sizeof(GRAPHEDGE) * g->capacity);
+    assert(g->list != 0);
+    return g;
+}
+
+///// PUBLIC FUNCTIONS ////
+// spreads the duplicate check over shards EDGESETs, before any edge is in
+extern void shardGRAPH(GRAPH * g,int shards){
+    assert(g != 0 && shards > 0 && g->size == 0);
+    for (int s = 0; s < g->shards; s++){
+        assert(sizeEDGESET(g->edges[s]) == 0);
+        freeEDGESET(g->edges[s]);
+    }
+    g->shards = shards;
+    g->edges = realloc(g->edges,sizeof(EDGESET *) * shards);
+    assert(g->edges != 0);
+    for (int s = 0; s < shards; s++){
+        g->edges[s] = newEDGESET();
+    }
+}
+extern int shardGRAPHedge(GRAPH * g,int v1,int v2){
+    assert(g != 0);
+    return (g->shards == 1) ? 0 : shardEDGESET(v1,v2,g->shards);
+}
+// returns 1 the first time edge (v1,v2) is kept and 0 after that, edges of
+// different shards can be kept on different threads at the same time
+extern int keepGRAPHedge(GRAPH * g,int v1,int v2){
+    assert(g != 0);
+    return insertEDGESET(g->edges[shardGRAPHedge(g,v1,v2)],v1,v2);
+}
+// returns the index of vertex number id, numbering it if it is new
+extern int addGRAPHvertex(GRAPH * g,int id){
+    assert(g != 0);
+    return insertINTERN(g->numbers,id);
+}
+// makes room for count more edges at the end of the list and returns the
+// position of the first, for setGRAPHedge to fill in
+extern int64_t extendGRAPH(GRAPH * g,int64_t count){
+    assert(g != 0 && count >= 0);
+    if (g->size + count > g->capacity){
+        while (g->size + count > g->capacity) g->capacity *= 2;
+        g->list = realloc(g->list,sizeof(GRAPHEDGE) * g->capacity);
+        assert(g->list != 0);
+    }
+    g->size += count;
+    return g->size - count;
+}
+// the vertices must have been added already, so different positions can
+// be set on different threads at the same time
+extern void setGRAPHedge(GRAPH * g,int64_t position,int v1,int v2,int weight){
+    assert(g != 0 && position >= 0 && position < g->size);
+    GRAPHEDGE * edge = &g->list[position];
+    edge->v1 = findINTERN(g->numbers,v1);
+    edge->v2 = findINTERN(g->numbers,v2);
+    edge->weight = weight;
+}
+extern void insertGRAPHedge(GRAPH * g,int v1,int v2,int weight){
+    assert(g != 0);
+    // the first occurrence of an edge wins, later DUPLICATES are dropped
+    if (keepGRAPHedge(g,v1,v2) == 0) return;
+    int index1 = insertINTERN(g->numbers,v1);
+    // doesn't add any more if it is a loop
+    if (v1 == v2) return;
+    int index2 = insertINTERN(g->numbers,v2);
+    if (g->size == g->capacity){
+        g->capacity *= 2;
+        g->list = realloc(g->list,sizeof(GRAPHEDGE) * g->capacity);
+        assert(g->list != 0);
+    }
+    g->list[g->size].v1 = index1;
+    g->list[g->size].v2 = index2;
+    g->list[g->size].weight = weight;
+    g->size++;
+}
+// what a reader knows ahead of time about the vertex numbers still to come
+extern void hintGRAPH(GRAPH * g,int smallest,int largest,long long edges){
+    assert(g != 0);
+    hintINTERN(g->numbers,smallest,largest,2 * edges);
+}
+extern int sizeGRAPH(GRAPH * g){
+    if (g == 0) return 0;
+    return sizeINTERN(g->numbers);
+}
+extern CSR *getGRAPHcsr(GRAPH * g){
+    assert(g != 0);
+    int vertices = sizeINTERN(g->numbers);
+    CSR * c = newCSR(vertices,2 * g->size);
+    int * ids = getCSRids(c);
+    int64_t * offsets = getCSRoffsets(c);
+    CSRARC * arcs = getCSRarcs(c);
+    int * numbers = getINTERNids(g->numbers);
+    // count the degrees into offsets[i+1] and turn them into starting points
+    for (int i = 0; i <= vertices; i++){
+        offsets[i] = 0;
+    }
+    for (int64_t e = 0; e < g->size; e++){
+        offsets[g->list[e].v1 + 1]++;
+        offsets[g->list[e].v2 + 1]++;
+    }
+    for (int i = 0; i < vertices; i++){
+        ids[i] = numbers[i];
+        offsets[i + 1] += offsets[i];
+    }
+    // offsets[i] is used as the fill point of vertex i, ending at offsets[i+1]
+    for (int64_t e = 0; e < g->size; e++){
+        GRAPHEDGE * edge = &g->list[e];
+        arcs[offsets[edge->v1]].vertex = edge->v2;
+        arcs[offsets[edge->v1]].weight = edge->weight;
+        offsets[edge->v1]++;
+        arcs[offsets[edge->v2]].vertex = edge->v1;
+        arcs[offsets[edge->v2]].weight = edge->weight;
+        offsets[edge->v2]++;
+    }
+    // shift the fill points back into starting points
+    for (int i = vertices; i > 0; i--){
+        offsets[i] = offsets[i - 1];
+    }
+    offsets[0] = 0;
+    return c;
+}
+extern void freeGRAPH(GRAPH * g){
+    assert(g != 0);
+    for (int s = 0; s < g->shards; s++){
+        freeEDGESET(g->edges[s]);
+    }
+    free(g->edges);
+    freeINTERN(g->numbers);
+    free(g->list);
+    free((GRAPH *)g);
+}
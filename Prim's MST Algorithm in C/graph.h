@@ -0,0 +1,22 @@
+#ifndef __GRAPH_INCLUDED__
+#define __GRAPH_INCLUDED__
+
+#include <stdio.h>
+#include "csr.h"
+
+typedef struct graph GRAPH;
+
+extern GRAPH *newGRAPH(void);
+extern void hintGRAPH(GRAPH *g,int smallest,int largest,long long edges);
+extern void insertGRAPHedge(GRAPH *g,int v1,int v2,int weight);
+extern void shardGRAPH(GRAPH *g,int shards);
+extern int shardGRAPHedge(GRAPH *g,int v1,int v2);
+extern int keepGRAPHedge(GRAPH *g,int v1,int v2);
+extern int addGRAPHvertex(GRAPH *g,int id);
+extern int64_t extendGRAPH(GRAPH *g,int64_t count);
+extern void setGRAPHedge(GRAPH *g,int64_t position,int v1,int v2,int weight);
+extern int sizeGRAPH(GRAPH *g);
+extern CSR *getGRAPHcsr(GRAPH *g);
+extern void freeGRAPH(GRAPH *g);
+
+#endif
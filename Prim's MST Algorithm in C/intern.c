@@ -0,0 +1,191 @@
+/*
+ *  An INTERN table maps the vertex numbers found in the input onto dense
+ *  indices 0..V-1, handed out in the order the numbers are first seen.
+ *  The numbers are kept in an open addressing hash table with linear
+ *  probing and in an array indexed by the dense index, so both directions
+ *  are a single lookup. The table doubles when it becomes half full.
+ *
+ *  When the numbers are small non-negative integers, as they usually are,
+ *  the hash table is skipped altogether: the index of number n is held
+ *  in a direct array at position n. The table starts out that way and
+ *  moves every number over to hashing, for good, the first time a number
+ *  is negative or too large for the direct array to stay dense. A reader
+ *  that knows the range of the numbers ahead of time can say so with
+ *  hintINTERN, so the decision does not depend on the order they come in.
+ *
+ *  insertINTERN returns the index of a number, giving it the next free
+ *  index if it is new. findINTERN returns -1 for a number never inserted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include "intern.h"
+
+// the direct array may hold DENSE_FACTOR slots per number plus DENSE_MINIMUM
+#define DENSE_FACTOR 4
+#define DENSE_MINIMUM (1 << 16)
+
+typedef struct internslot{
+    int id;
+    int index;      // -1 for an empty slot
+}INTERNSLOT;
+
+struct intern{
+    int * direct;       // index by number, 0 once the table hashes
+    int directSize;
+    INTERNSLOT * slots; // 0 while the table is direct
+    uint32_t mask;      // capacity - 1, the capacity being a power of 2
+    int * ids;          // the number given each index
+    int size;
+    int capacity;       // of ids
+};
+
+/// Private helper FUNCTIONS ///
+static uint32_t hashId(int id){
+    uint32_t x = (uint32_t)id;
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+static INTERNSLOT *allocateSlots(uint32_t capacity){
+    INTERNSLOT * slots = malloc(sizeof(INTERNSLOT) * capacity);
+    assert(slots != 0);
+    for (uint32_t i = 0; i < capacity; i++){
+        slots[i].index = -1;
+    }
+    return slots;
+}
+static int isDense(long long largest,long long expected){
+    return largest < DENSE_MINIMUM + DENSE_FACTOR * expected;
+}
+static void growDirect(INTERN * t,int size){
+    t->direct = realloc(t->direct,sizeof(int) * size);
+    assert(t->direct != 0);
+    for (int i = t->directSize; i < size; i++){
+        t->direct[i] = -1;
+    }
+    t->directSize = size;
+}
+static void rehash(INTERN * t,uint32_t capacity){
+    free(t->slots);
+    t->mask = capacity - 1;
+    t->slots = allocateSlots(capacity);
+    // every number is still in ids, so the table is rebuilt from there
+    for (int i = 0; i < t->size; i++){
+        uint32_t slot = hashId(t->ids[i]) & t->mask;
+        while (t->slots[slot].index != -1){
+            slot = (slot + 1) & t->mask;
+        }
+        t->slots[slot].id = t->ids[i];
+        t->slots[slot].index = i;
+    }
+}
+static void grow(INTERN * t){
+    rehash(t,(t->mask + 1) * 2);
+}
+// gives up on the direct array, from now on every number is hashed
+static void stopDirect(INTERN * t){
+    uint32_t capacity = 1024;
+    while (capacity < (uint32_t)t->size * 2 + 2) capacity *= 2;
+    free(t->direct);
+    t->direct = 0;
+    t->directSize = 0;
+    rehash(t,capacity);
+}
+static int appendId(INTERN * t,int id){
+    if (t->size == t->capacity){
+        t->capacity *= 2;
+        t->ids = realloc(t->ids,sizeof(int) * t->capacity);
+        assert(t->ids != 0);
+    }
+    t->ids[t->size] = id;
+    t->size++;
+    return t->size - 1;
+}
+
+//Constructor
+extern INTERN *newINTERN(void){
+    INTERN * t = malloc(sizeof(INTERN));
+    assert(t != 0);
+    t->direct = 0;
+    t->directSize = 0;
+    growDirect(t,1024);
+    t->slots = 0;
+    t->mask = 0;
+    t->capacity = 512;
+    t->ids = malloc(sizeof(int) * t->capacity);
+    assert(t->ids != 0);
+    t->size = 0;
+    return t;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void hintINTERN(INTERN * t,int smallest,int largest,long long expected){
+    assert(t != 0);
+    if (t->direct == 0) return;
+    if (smallest < 0 || !isDense(largest,expected)) stopDirect(t);
+    else if (largest >= t->directSize) growDirect(t,largest + 1);
+}
+extern int insertINTERN(INTERN * t,int id){
+    assert(t != 0);
+    if (t->direct != 0){
+        if (id >= t->directSize && isDense(id,t->size + 1)){
+            long long size = 2LL * t->directSize;
+            if (size <= id) size = (long long)id + 1;
+            growDirect(t,(size > INT_MAX) ? INT_MAX : size);
+        }
+        if (id >= 0 && id < t->directSize){
+            if (t->direct[id] == -1) t->direct[id] = appendId(t,id);
+            return t->direct[id];
+        }
+        stopDirect(t);
+    }
+    uint32_t slot = hashId(id) & t->mask;
+    while (t->slots[slot].index != -1){
+        if (t->slots[slot].id == id) return t->slots[slot].index;
+        slot = (slot + 1) & t->mask;
+    }
+    int index = appendId(t,id);
+    t->slots[slot].id = id;
+    t->slots[slot].index = index;
+    if ((uint32_t)t->size * 2 > t->mask + 1) grow(t);
+    return index;
+}
+extern int findINTERN(INTERN * t,int id){
+    assert(t != 0);
+    if (t->direct != 0){
+        if (id < 0 || id >= t->directSize) return -1;
+        return t->direct[id];
+    }
+    uint32_t slot = hashId(id) & t->mask;
+    while (t->slots[slot].index != -1){
+        if (t->slots[slot].id == id) return t->slots[slot].index;
+        slot = (slot + 1) & t->mask;
+    }
+    return -1;
+}
+extern int getINTERNid(INTERN * t,int index){
+    assert(t != 0 && index >= 0 && index < t->size);
+    return t->ids[index];
+}
+extern int *getINTERNids(INTERN * t){
+    assert(t != 0);
+    return t->ids;
+}
+extern int sizeINTERN(INTERN * t){
+    if (t == 0) return 0;
+    return t->size;
+}
+extern void freeINTERN(INTERN * t){
+    assert(t != 0);
+    free(t->direct);
+    free(t->slots);
+    free(t->ids);
+    free((INTERN *)t);
+}
@@ -0,0 +1,17 @@
+#ifndef __INTERN_INCLUDED__
+#define __INTERN_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct intern INTERN;
+
+extern INTERN *newINTERN(void);
+extern void hintINTERN(INTERN *t,int smallest,int largest,long long expected);
+extern int insertINTERN(INTERN *t,int id);
+extern int findINTERN(INTERN *t,int id);
+extern int getINTERNid(INTERN *t,int index);
+extern int *getINTERNids(INTERN *t);
+extern int sizeINTERN(INTERN *t);
+extern void freeINTERN(INTERN *t);
+
+#endif
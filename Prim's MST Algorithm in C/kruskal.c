@@ -0,0 +1,222 @@
+/*
+ *  Kruskal's algorithm over a CSR. Every edge is taken once, from its
+ *  lower numbered end, the edges are sorted by weight and each one that
+ *  joins two different trees of the forest so far is kept, the trees
+ *  being tracked in a disjoint SET.
+ *
+ *  Edges of equal weight are taken in the order of their endpoints, so
+ *  the forest is always the same for the same graph, although it need
+ *  not be the tree prim picks among equal weights.
+ *
+ *  filterKruskalMST finds the same forest without sorting every edge. The
+ *  edges are partitioned around a pivot like quicksort, the light side is
+ *  solved first and the heavy side is then filtered, dropping each edge
+ *  whose ends the light side already connected, before it is partitioned
+ *  in turn. On a graph with many more edges than vertices most of the
+ *  heavy edges are filtered out long before they would be sorted. The
+ *  partition and the filter each split a large range into one slice per
+ *  thread of a POOL: the slices are done in parallel and then packed
+ *  together in order, so the result does not depend on the threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "kruskal.h"
+#include "set.h"
+
+// ranges this short are sorted outright
+#define FILTERSORT 1024
+// ranges this short are partitioned and filtered on the calling thread
+#define FILTERPARALLEL 65536
+
+typedef struct filter{
+    MSTEDGE * from;     // the range being partitioned or filtered
+    MSTEDGE * to;       // where it is packed, at the same offsets
+    int64_t count;
+    int slices;
+    MSTEDGE pivot;
+    SET * forest;
+    int64_t * kept;     // the light edges, or the edges that pass, of each slice
+    int64_t * targets;  // where the edges of each slice are packed
+    MSTEDGE * tree;
+    int treeSize;
+    int vertices;
+    POOL * pool;
+}FILTER;
+
+/// Private helper FUNCTIONS ///
+static int compareMSTEDGE(const void * a,const void * b){
+    const MSTEDGE * x = a;
+    const MSTEDGE * y = b;
+    if (x->weight != y->weight) return (x->weight > y->weight) ? 1 : -1;
+    if (x->v1 != y->v1) return (x->v1 > y->v1) ? 1 : -1;
+    return (x->v2 > y->v2) - (x->v2 < y->v2);
+}
+
+// every edge is taken once, from its lower numbered end
+static int64_t gatherEdges(CSR * graph,MSTEDGE * edges){
+    int vertices = sizeCSR(graph);
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
+    int64_t count = 0;
+    for (int u = 0; u < vertices; u++){
+        for (int64_t a = offsets[u]; a < offsets[u + 1]; a++){
+            if (arcs[a].vertex <= u) continue;
+            edges[count].v1 = u;
+            edges[count].v2 = arcs[a].vertex;
+            edges[count].weight = arcs[a].weight;
+            count++;
+        }
+    }
+    return count;
+}
+
+//// filter kruskal ////
+// the slices of a pass run on the pool, or on the calling thread when short
+static void runSlices(FILTER * f,POOLTASK task){
+    if (f->slices == 1) task(f,0,f->count,0);
+    else runPOOL(f->pool,task,f,f->count);
+}
+static void countLight(void * arg,int64_t begin,int64_t end,int slice){
+    FILTER * f = arg;
+    int64_t light = 0;
+    for (int64_t e = begin; e < end; e++){
+        if (compareMSTEDGE(&f->from[e],&f->pivot) <= 0) light++;
+    }
+    f->kept[slice] = light;
+}
+// light edges go to the front of to and heavy ones after them
+static void scatterPartition(void * arg,int64_t begin,int64_t end,int slice){
+    FILTER * f = arg;
+    int64_t light = f->targets[slice];
+    int64_t heavy = f->targets[f->slices] + begin - f->targets[slice];
+    for (int64_t e = begin; e < end; e++){
+        if (compareMSTEDGE(&f->from[e],&f->pivot) <= 0) f->to[light++] = f->from[e];
+        else f->to[heavy++] = f->from[e];
+    }
+}
+// the edges that pass are moved to the front of their own slice
+static void filterSlice(void * arg,int64_t begin,int64_t end,int slice){
+    FILTER * f = arg;
+    int64_t kept = begin;
+    for (int64_t e = begin; e < end; e++){
+        if (sameSET(f->forest,f->from[e].v1,f->from[e].v2)) continue;
+        f->from[kept++] = f->from[e];
+    }
+    f->kept[slice] = kept - begin;
+}
+static void packSlice(void * arg,int64_t begin,int64_t end,int slice){
+    FILTER * f = arg;
+    (void)end;
+    memcpy(f->to + f->targets[slice],f->from + begin,sizeof(MSTEDGE) * f->kept[slice]);
+}
+static void prefixTargets(FILTER * f){
+    f->targets[0] = 0;
+    for (int i = 0; i < f->slices; i++){
+        f->targets[i + 1] = f->targets[i] + f->kept[i];
+    }
+}
+static void setRange(FILTER * f,MSTEDGE * from,MSTEDGE * to,int64_t count){
+    f->from = from;
+    f->to = to;
+    f->count = count;
+    f->slices = (count < FILTERPARALLEL) ? 1 : threadsPOOL(f->pool);
+}
+static int64_t partitionEdges(FILTER * f,MSTEDGE * from,MSTEDGE * to,int64_t count){
+    setRange(f,from,to,count);
+    // the median of three, no two edges compare equal
+    MSTEDGE * a = &from[0];
+    MSTEDGE * b = &from[count / 2];
+    MSTEDGE * c = &from[count - 1];
+    if (compareMSTEDGE(a,b) > 0){
+        MSTEDGE * temp = a;
+        a = b;
+        b = temp;
+    }
+    if (compareMSTEDGE(b,c) > 0) b = (compareMSTEDGE(a,c) > 0) ? a : c;
+    f->pivot = *b;
+    runSlices(f,countLight);
+    prefixTargets(f);
+    runSlices(f,scatterPartition);
+    return f->targets[f->slices];
+}
+static int64_t filterEdges(FILTER * f,MSTEDGE * from,MSTEDGE * to,int64_t count){
+    setRange(f,from,to,count);
+    runSlices(f,filterSlice);
+    prefixTargets(f);
+    runSlices(f,packSlice);
+    return f->targets[f->slices];
+}
+static void kruskalEdges(FILTER * f,MSTEDGE * edges,int64_t count){
+    qsort(edges,count,sizeof(MSTEDGE),compareMSTEDGE);
+    for (int64_t e = 0; e < count && f->treeSize < f->vertices - 1; e++){
+        if (unionSET(f->forest,edges[e].v1,edges[e].v2)){
+            f->tree[f->treeSize] = edges[e];
+            f->treeSize++;
+        }
+    }
+}
+// edges and scratch are the same range of the two edge arrays
+static void filterKruskal(FILTER * f,MSTEDGE * edges,MSTEDGE * scratch,int64_t count){
+    while (count > 0 && f->treeSize < f->vertices - 1){
+        if (count <= FILTERSORT){
+            kruskalEdges(f,edges,count);
+            return;
+        }
+        int64_t light = partitionEdges(f,edges,scratch,count);
+        filterKruskal(f,scratch,edges,light);
+        if (f->treeSize == f->vertices - 1) return;
+        // the heavy side comes back filtered into edges and is done next
+        count = filterEdges(f,scratch + light,edges + light,count - light);
+        edges += light;
+        scratch += light;
+    }
+}
+
+///// PUBLIC FUNCTIONS ////
+// fills tree with the edges of a minimum spanning forest and returns how many
+// tree needs room for one edge less than there are vertices
+extern int kruskalMST(CSR * graph,MSTEDGE * tree){
+    int vertices = sizeCSR(graph);
+    MSTEDGE * edges = malloc(sizeof(MSTEDGE) * (arcsCSR(graph) / 2 + 1));
+    assert(edges != 0);
+    int64_t count = gatherEdges(graph,edges);
+    qsort(edges,count,sizeof(MSTEDGE),compareMSTEDGE);
+    SET * forest = newSET(vertices);
+    int kept = 0;
+    for (int64_t e = 0; e < count && kept < vertices - 1; e++){
+        if (unionSET(forest,edges[e].v1,edges[e].v2)){
+            tree[kept] = edges[e];
+            kept++;
+        }
+    }
+    freeSET(forest);
+    free(edges);
+    return kept;
+}
+// the same forest as kruskalMST, partitioning and filtering on the pool
+extern int filterKruskalMST(CSR * graph,MSTEDGE * tree,POOL * pool){
+    FILTER f;
+    int threads = threadsPOOL(pool);
+    int64_t size = arcsCSR(graph) / 2 + 1;
+    MSTEDGE * edges = malloc(sizeof(MSTEDGE) * size);
+    MSTEDGE * scratch = malloc(sizeof(MSTEDGE) * size);
+    f.kept = malloc(sizeof(int64_t) * threads);
+    f.targets = malloc(sizeof(int64_t) * (threads + 1));
+    assert(edges != 0 && scratch != 0 && f.kept != 0 && f.targets != 0);
+    int64_t count = gatherEdges(graph,edges);
+    f.vertices = sizeCSR(graph);
+    f.forest = newSET(f.vertices);
+    f.tree = tree;
+    f.treeSize = 0;
+    f.pool = pool;
+    filterKruskal(&f,edges,scratch,count);
+    freeSET(f.forest);
+    free(edges);
+    free(scratch);
+    free(f.kept);
+    free(f.targets);
+    return f.treeSize;
+}
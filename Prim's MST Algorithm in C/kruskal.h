@@ -0,0 +1,17 @@
+#ifndef __KRUSKAL_INCLUDED__
+#define __KRUSKAL_INCLUDED__
+
+#include <stdio.h>
+#include "csr.h"
+#include "pool.h"
+
+typedef struct mstedge{
+    int v1;     // vertex indices of the CSR
+    int v2;
+    int weight;
+}MSTEDGE;
+
+extern int kruskalMST(CSR *graph,MSTEDGE *tree);
+extern int filterKruskalMST(CSR *graph,MSTEDGE *tree,POOL *pool);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ *  A plain binary min heap of (key, vertex) entries for lazy prim. There
+ *  is no position array and no decreaseKey: a vertex whose key drops is
+ *  simply pushed again, and the entries left behind with the old keys
+ *  are skipped by the caller once the vertex has been taken out of the
+ *  tree. A vertex can therefore be in the heap many times, so the array
+ *  doubles when it fills up instead of being sized to the vertices.
+ *
+ *  Ties on the key are broken on rank[vertex] as in the DARY heap, so a
+ *  stale entry never comes out ahead of the live entry for its vertex and
+ *  the extraction order matches compareVERTEX. With a null rank, ties are
+ *  broken on the index.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lazy.h"
+
+typedef struct lazyentry{
+    int key;
+    int vertex;
+}LAZYENTRY;
+
+struct lazy{
+    LAZYENTRY * heap;
+    int * rank;
+    int64_t size;
+    int64_t capacity;
+};
+
+//Constructor
+extern LAZY *newLAZY(int capacity,int * rank){
+    LAZY * h = malloc(sizeof(LAZY));
+    assert(h != 0);
+    h->capacity = (capacity < 16) ? 16 : capacity;
+    h->heap = malloc(sizeof(LAZYENTRY) * h->capacity);
+    assert(h->heap != 0);
+    h->rank = rank;
+    h->size = 0;
+    return h;
+}
+
+/// Private helper FUNCTIONS ///
+static int less(LAZY * h,LAZYENTRY a,LAZYENTRY b){
+    if (a.key != b.key) return a.key < b.key;
+    if (h->rank != 0) return h->rank[a.vertex] < h->rank[b.vertex];
+    return a.vertex < b.vertex;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void pushLAZY(LAZY * h,int vertex,int key){
+    assert(h != 0);
+    if (h->size == h->capacity){
+        h->capacity *= 2;
+        h->heap = realloc(h->heap,sizeof(LAZYENTRY) * h->capacity);
+        assert(h->heap != 0);
+    }
+    LAZYENTRY e = {key,vertex};
+    int64_t slot = h->size;
+    h->size++;
+    while (slot > 0){
+        int64_t parent = (slot - 1) / 2;
+        if (!less(h,e,h->heap[parent])) break;
+        h->heap[slot] = h->heap[parent];
+        slot = parent;
+    }
+    h->heap[slot] = e;
+}
+extern int peekLAZY(LAZY * h){
+    assert(h != 0 && h->size > 0);
+    return h->heap[0].vertex;
+}
+// returns the vertex of the smallest entry, and its key through key if not null
+extern int popLAZY(LAZY * h,int * key){
+    assert(h != 0 && h->size > 0);
+    LAZYENTRY top = h->heap[0];
+    h->size--;
+    if (h->size > 0){
+        LAZYENTRY e = h->heap[h->size];
+        int64_t slot = 0;
+        while (1){
+            int64_t child = slot * 2 + 1;
+            if (child >= h->size) break;
+            if (child + 1 < h->size && less(h,h->heap[child + 1],h->heap[child])) child++;
+            if (!less(h,h->heap[child],e)) break;
+            h->heap[slot] = h->heap[child];
+            slot = child;
+        }
+        h->heap[slot] = e;
+    }
+    if (key != 0) *key = top.key;
+    return top.vertex;
+}
+extern int64_t sizeLAZY(LAZY * h){
+    if (h == 0) return 0;
+    return h->size;
+}
+extern void displayLAZY(LAZY * h,FILE * fp){
+    assert(h != 0);
+    if (h->size == 0){
+        fprintf(fp,"EMPTY\n");
+        return;
+    }
+    for (int64_t i = 0; i < h->size; i++){
+        if (i > 0) fprintf(fp," ");
+        fprintf(fp,"%d(%d)",h->heap[i].vertex,h->heap[i].key);
+    }
+    fprintf(fp,"\n");
+}
+extern void freeLAZY(LAZY * h){
+    assert(h != 0);
+    free(h->heap);
+    free((LAZY *)h);
+}
@@ -0,0 +1,17 @@
+#ifndef __LAZY_INCLUDED__
+#define __LAZY_INCLUDED__
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef struct lazy LAZY;
+
+extern LAZY *newLAZY(int capacity,int *rank);
+extern void pushLAZY(LAZY *h,int vertex,int key);
+extern int peekLAZY(LAZY *h);
+extern int popLAZY(LAZY *h,int *key);
+extern int64_t sizeLAZY(LAZY *h);
+extern void displayLAZY(LAZY *h,FILE *fp);
+extern void freeLAZY(LAZY *h);
+
+#endif
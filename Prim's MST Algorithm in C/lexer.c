@@ -0,0 +1,114 @@
+/*
+ *  A resumable LEXER for the edge-list graph format read by prim.
+ *
+ *  The input is a sequence of records terminated by ';', each holding
+ *  two vertex numbers and an optional weight:  1 3 4 ; 1 2 ;
+ *  A missing weight defaults to 1, tokens past the third are ignored and
+ *  records with fewer than two numbers are skipped. Tokens are converted
+ *  the way atoi would convert them.
+ *
+ *  The LEXER never allocates per token. It is fed consecutive slices of
+ *  the input with feedLEXER and readLEXER hands back one edge at a time,
+ *  returning 0 once the current slice is used up. A token or record that
+ *  straddles two slices is carried over, so the slices may be cut at any
+ *  byte. finishLEXER flushes a last record that has no closing ';'.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lexer.h"
+
+struct lexer{
+    const char * current;
+    const char * end;
+    int fields[3];
+    int count;          // tokens seen in the current record
+    int inToken;
+    int scanning;       // still inside the leading digits of the token
+    int negative;
+    unsigned int value;
+};
+
+extern LEXER *newLEXER(void){
+    LEXER * l = malloc(sizeof(LEXER));
+    assert(l != 0);
+    l->current = 0;
+    l->end = 0;
+    l->count = 0;
+    l->inToken = 0;
+    l->scanning = 0;
+    l->negative = 0;
+    l->value = 0;
+    return l;
+}
+extern void feedLEXER(LEXER * l,const char * buffer,size_t length){
+    assert(l != 0);
+    l->current = buffer;
+    l->end = buffer + length;
+}
+
+/// Private helper FUNCTIONS ///
+static int isBlank(char c){
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+static void endToken(LEXER * l){
+    if (!l->inToken) return;
+    if (l->count < 3){
+        l->fields[l->count] = l->negative ? -(int)l->value : (int)l->value;
+        l->count++;
+    }
+    l->inToken = 0;
+}
+// hands back the finished record if it describes an edge, always starts a new one
+static int endRecord(LEXER * l,int * v1,int * v2,int * weight){
+    endToken(l);
+    int found = l->count >= 2;
+    if (found){
+        *v1 = l->fields[0];
+        *v2 = l->fields[1];
+        *weight = (l->count == 3) ? l->fields[2] : 1;
+    }
+    l->count = 0;
+    return found;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int readLEXER(LEXER * l,int * v1,int * v2,int * weight){
+    assert(l != 0);
+    const char * p = l->current;
+    const char * end = l->end;
+    while (p < end){
+        char c = *p++;
+        if (c == ';'){
+            if (endRecord(l,v1,v2,weight)){
+                l->current = p;
+                return 1;
+            }
+        }
+        else if (isBlank(c)){
+            endToken(l);
+        }
+        else if (!l->inToken){
+            l->inToken = 1;
+            l->scanning = 1;
+            l->negative = (c == '-');
+            l->value = 0;
+            if (c >= '0' && c <= '9') l->value = c - '0';
+            else if (c != '-' && c != '+') l->scanning = 0;
+        }
+        else if (l->scanning){
+            if (c >= '0' && c <= '9') l->value = l->value * 10 + (c - '0');
+            else l->scanning = 0;
+        }
+    }
+    l->current = p;
+    return 0;
+}
+extern int finishLEXER(LEXER * l,int * v1,int * v2,int * weight){
+    assert(l != 0);
+    return endRecord(l,v1,v2,weight);
+}
+extern void freeLEXER(LEXER * l){
+    free((LEXER *)l);
+}
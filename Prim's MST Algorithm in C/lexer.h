@@ -0,0 +1,14 @@
+#ifndef __LEXER_INCLUDED__
+#define __LEXER_INCLUDED__
+
+#include <stddef.h>
+
+typedef struct lexer LEXER;
+
+extern LEXER *newLEXER(void);
+extern void feedLEXER(LEXER *l,const char *buffer,size_t length);
+extern int readLEXER(LEXER *l,int *v1,int *v2,int *weight);
+extern int finishLEXER(LEXER *l,int *v1,int *v2,int *weight);
+extern void freeLEXER(LEXER *l);
+
+#endif
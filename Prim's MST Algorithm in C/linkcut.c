@@ -0,0 +1,211 @@
+/*
+ *  A forest of LINKCUT trees. Each node holds a value and the forest can
+ *  be linked, cut and asked for the node of largest value on the path
+ *  between two nodes, all in O(log n) amortized.
+ *
+ *  Every tree is cut into preferred paths, each path kept in a splay tree
+ *  ordered by depth and hung from the node above the top of its path by a
+ *  parent pointer that the node does not point back along. access makes
+ *  the path from the root of the tree to a node preferred, after which the
+ *  node's splay tree holds exactly that path. A reverse flag, pushed down
+ *  lazily, turns a path over, which is how any node is made the root.
+ *  Each splay node keeps the node of largest value in its subtree.
+ *
+ *  Nodes are numbered from 0 in the order they are made, numbers of freed
+ *  nodes being handed out again. A node may only be freed once it has
+ *  been cut from everything.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "linkcut.h"
+
+typedef struct linkcutnode{
+    int child[2];   // the shallower and the deeper part of the path, -1 for none
+    int parent;     // in the splay tree, or the path parent, -1 for none
+    int reverse;    // the children are still to be swapped below here
+    int max;        // the node of largest value in this splay subtree
+    int64_t value;
+}LinkcutNODE;
+
+struct linkcut{
+    LinkcutNODE * nodes;
+    int size;
+    int capacity;
+    int * released;     // freed node numbers
+    int releasedCount;
+    int * stack;        // the nodes a splay pushes the reverse flags down over
+};
+
+//Constructor
+extern LINKCUT *newLINKCUT(void){
+    LINKCUT * l = malloc(sizeof(LINKCUT));
+    assert(l != 0);
+    l->capacity = 64;
+    l->size = 0;
+    l->releasedCount = 0;
+    l->nodes = malloc(sizeof(LinkcutNODE) * l->capacity);
+    l->released = malloc(sizeof(int) * l->capacity);
+    l->stack = malloc(sizeof(int) * l->capacity);
+    assert(l->nodes != 0 && l->released != 0 && l->stack != 0);
+    return l;
+}
+
+/// Private helper FUNCTIONS ///
+static int isSplayRoot(LINKCUT * l,int x){
+    int p = l->nodes[x].parent;
+    return p == -1 || (l->nodes[p].child[0] != x && l->nodes[p].child[1] != x);
+}
+static void pushDown(LINKCUT * l,int x){
+    LinkcutNODE * n = &l->nodes[x];
+    if (n->reverse == 0) return;
+    int temp = n->child[0];
+    n->child[0] = n->child[1];
+    n->child[1] = temp;
+    if (n->child[0] != -1) l->nodes[n->child[0]].reverse ^= 1;
+    if (n->child[1] != -1) l->nodes[n->child[1]].reverse ^= 1;
+    n->reverse = 0;
+}
+static void pullUp(LINKCUT * l,int x){
+    LinkcutNODE * n = &l->nodes[x];
+    n->max = x;
+    for (int side = 0; side < 2; side++){
+        int c = n->child[side];
+        if (c != -1 && l->nodes[l->nodes[c].max].value > l->nodes[n->max].value) n->max = l->nodes[c].max;
+    }
+}
+static void rotate(LINKCUT * l,int x){
+    int p = l->nodes[x].parent;
+    int g = l->nodes[p].parent;
+    int side = (l->nodes[p].child[1] == x);
+    int moved = l->nodes[x].child[side ^ 1];
+    if (!isSplayRoot(l,p)){
+        if (l->nodes[g].child[0] == p) l->nodes[g].child[0] = x;
+        else l->nodes[g].child[1] = x;
+    }
+    l->nodes[x].parent = g;
+    l->nodes[x].child[side ^ 1] = p;
+    l->nodes[p].parent = x;
+    l->nodes[p].child[side] = moved;
+    if (moved != -1) l->nodes[moved].parent = p;
+    pullUp(l,p);
+    pullUp(l,x);
+}
+static void splay(LINKCUT * l,int x){
+    // the flags are pushed down from the top of the splay tree first
+    int depth = 0;
+    l->stack[depth++] = x;
+    for (int y = x; !isSplayRoot(l,y); y = l->nodes[y].parent){
+        l->stack[depth++] = l->nodes[y].parent;
+    }
+    while (depth > 0){
+        pushDown(l,l->stack[--depth]);
+    }
+    while (!isSplayRoot(l,x)){
+        int p = l->nodes[x].parent;
+        if (!isSplayRoot(l,p)){
+            int g = l->nodes[p].parent;
+            int zigzig = (l->nodes[g].child[0] == p) == (l->nodes[p].child[0] == x);
+            rotate(l,zigzig ? p : x);
+        }
+        rotate(l,x);
+    }
+}
+static void access(LINKCUT * l,int x){
+    int last = -1;
+    for (int y = x; y != -1; y = l->nodes[y].parent){
+        splay(l,y);
+        l->nodes[y].child[1] = last;
+        pullUp(l,y);
+        last = y;
+    }
+    splay(l,x);
+}
+static void makeRoot(LINKCUT * l,int x){
+    access(l,x);
+    l->nodes[x].reverse ^= 1;
+}
+
+///// PUBLIC FUNCTIONS ////
+// a new node of its own tree, returning its number
+extern int newLINKCUTnode(LINKCUT * l,int64_t value){
+    int x;
+    if (l->releasedCount > 0) x = l->released[--l->releasedCount];
+    else{
+        if (l->size == l->capacity){
+            l->capacity *= 2;
+            l->nodes = realloc(l->nodes,sizeof(LinkcutNODE) * l->capacity);
+            l->released = realloc(l->released,sizeof(int) * l->capacity);
+            l->stack = realloc(l->stack,sizeof(int) * l->capacity);
+            assert(l->nodes != 0 && l->released != 0 && l->stack != 0);
+        }
+        x = l->size++;
+    }
+    LinkcutNODE * n = &l->nodes[x];
+    n->child[0] = -1;
+    n->child[1] = -1;
+    n->parent = -1;
+    n->reverse = 0;
+    n->max = x;
+    n->value = value;
+    return x;
+}
+// x must already be cut from every other node
+extern void freeLINKCUTnode(LINKCUT * l,int x){
+    assert(x >= 0 && x < l->size);
+    l->released[l->releasedCount++] = x;
+}
+extern int64_t getLINKCUTvalue(LINKCUT * l,int x){
+    assert(x >= 0 && x < l->size);
+    return l->nodes[x].value;
+}
+// the nodes ever made, freed ones included
+extern int sizeLINKCUT(LINKCUT * l){
+    assert(l != 0);
+    return l->size;
+}
+// x and y must be in different trees
+extern void linkLINKCUT(LINKCUT * l,int x,int y){
+    makeRoot(l,x);
+    l->nodes[x].parent = y;
+}
+// x and y must be neighbors
+extern void cutLINKCUT(LINKCUT * l,int x,int y){
+    makeRoot(l,x);
+    access(l,y);
+    // the path is now x y, x being the shallower part of y's splay tree
+    assert(l->nodes[y].child[0] == x && l->nodes[x].child[1] == -1);
+    l->nodes[y].child[0] = -1;
+    l->nodes[x].parent = -1;
+    pullUp(l,y);
+}
+extern int findLINKCUTroot(LINKCUT * l,int x){
+    access(l,x);
+    int root = x;
+    while (1){
+        pushDown(l,root);
+        if (l->nodes[root].child[0] == -1) break;
+        root = l->nodes[root].child[0];
+    }
+    // splaying keeps a long path from being walked again
+    splay(l,root);
+    return root;
+}
+extern int connectedLINKCUT(LINKCUT * l,int x,int y){
+    if (x == y) return 1;
+    return findLINKCUTroot(l,x) == findLINKCUTroot(l,y);
+}
+// the node of largest value on the path from x to y, which must be connected
+extern int maxLINKCUT(LINKCUT * l,int x,int y){
+    makeRoot(l,x);
+    access(l,y);
+    return l->nodes[y].max;
+}
+extern void freeLINKCUT(LINKCUT * l){
+    assert(l != 0);
+    free(l->nodes);
+    free(l->released);
+    free(l->stack);
+    free((LINKCUT *)l);
+}
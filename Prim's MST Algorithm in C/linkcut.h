@@ -0,0 +1,21 @@
+#ifndef __LINKCUT_INCLUDED__
+#define __LINKCUT_INCLUDED__
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef struct linkcut LINKCUT;
+
+extern LINKCUT *newLINKCUT(void);
+extern int newLINKCUTnode(LINKCUT *l,int64_t value);
+extern void freeLINKCUTnode(LINKCUT *l,int x);
+extern int64_t getLINKCUTvalue(LINKCUT *l,int x);
+extern int sizeLINKCUT(LINKCUT *l);
+extern void linkLINKCUT(LINKCUT *l,int x,int y);
+extern void cutLINKCUT(LINKCUT *l,int x,int y);
+extern int findLINKCUTroot(LINKCUT *l,int x);
+extern int connectedLINKCUT(LINKCUT *l,int x,int y);
+extern int maxLINKCUT(LINKCUT *l,int x,int y);
+extern void freeLINKCUT(LINKCUT *l);
+
+#endif
@@ -0,0 +1,357 @@
+/*
+ *  Reads an edge-list file into a GRAPH. The file is memory mapped and
+ *  walked with the LEXER a window at a time, each window cut just after a
+ *  ';'. The edges of a window are lexed once into a buffer, noting the
+ *  smallest and largest vertex numbers, which are handed to the builder
+ *  as a hint before the edges go in. Windows that have been consumed are
+ *  released again so the memory used for the input stays flat whatever
+ *  the size of the file.
+ *
+ *  With more than one thread, each round takes one window per thread and
+ *  cuts it into byte ranges, one a thread, that each end just after a ';'.
+ *  The GRAPH comes out exactly as the sequential reader would build it,
+ *  whatever the number of threads, in four steps:
+ *
+ *      every range is lexed on a thread of a POOL into a local edge
+ *      buffer, its vertex numbers listed in the order first seen and its
+ *      edges sorted by shard of the duplicate check into buckets
+ *
+ *      the vertices are numbered, range after range, on one thread. Only
+ *      the distinct numbers of each range are looked at, O(V) in all.
+ *
+ *      each shard, on a thread of its own, walks its bucket of every
+ *      range in file order, so the first copy of an edge is still the one
+ *      kept
+ *
+ *      the edges kept in each range are given their vertex indices on a
+ *      thread per range and put into the list from where the ranges
+ *      before it leave off
+ *
+ *  Standard input, named "-", pipes and other files that cannot be mapped
+ *  are streamed instead: bytes are read into a fixed buffer as they arrive
+ *  and fed to the LEXER, so the graph is built while the writer is still
+ *  producing it. End of input is a read of zero bytes, never feof.
+ *
+ *  streamEDGES reads a file the same way as a stream, whatever it is, and
+ *  hands each edge to a function the moment it has been read, for input
+ *  that has to be acted on as it comes in rather than built into a GRAPH.
+ *
+ *  loadGRAPH and streamEDGES return 0 if the file could not be opened or
+ *  read.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "loader.h"
+#include "lexer.h"
+#include "mapping.h"
+#include "intern.h"
+#include "pool.h"
+
+#define WINDOW (64 << 20)
+#define STREAMBUFFER (1 << 20)
+
+// the edges of a range that belong to one shard, by position in the range
+typedef struct bucket{
+    size_t * positions;
+    size_t count;
+    size_t capacity;
+}BUCKET;
+
+typedef struct chunk{
+    const char * data;
+    size_t length;
+    int * triples;      // v1, v2, weight of each edge lexed
+    size_t count;       // edges in triples
+    size_t capacity;    // edges triples can hold
+    int smallest;       // vertex numbers seen
+    int largest;
+    INTERN * seen;      // its vertex numbers in the order first seen
+    BUCKET * buckets;   // one per shard
+    char * kept;        // whether each edge was the first copy
+    size_t keptCapacity;
+    int64_t * placed;   // edges kept by each shard, loops excluded
+    int64_t position;   // of its first edge in the GRAPH list
+}CHUNK;
+
+// one round of the parallel reader
+typedef struct round{
+    GRAPH * g;
+    CHUNK * chunks;
+    int ranges;
+    int shards;
+}ROUND;
+
+/// Private helper FUNCTIONS ///
+static void appendTriple(CHUNK * c,int v1,int v2,int weight){
+    if (c->count == c->capacity){
+        c->capacity = (c->capacity == 0) ? 4096 : c->capacity * 2;
+        c->triples = realloc(c->triples,sizeof(int) * 3 * c->capacity);
+        assert(c->triples != 0);
+    }
+    int * t = c->triples + 3 * c->count;
+    t[0] = v1;
+    t[1] = v2;
+    t[2] = weight;
+    c->count++;
+}
+static void widenRange(int * smallest,int * largest,int v1,int v2){
+    if (v1 < *smallest) *smallest = v1;
+    if (v2 < *smallest) *smallest = v2;
+    if (v1 > *largest) *largest = v1;
+    if (v2 > *largest) *largest = v2;
+}
+static void *lexChunk(void * arg){
+    CHUNK * c = arg;
+    LEXER * l = newLEXER();
+    int v1 = 0;
+    int v2 = 0;
+    int weight = 0;
+    c->count = 0;
+    c->smallest = INT_MAX;
+    c->largest = INT_MIN;
+    feedLEXER(l,c->data,c->length);
+    while (readLEXER(l,&v1,&v2,&weight)){
+        appendTriple(c,v1,v2,weight);
+        widenRange(&c->smallest,&c->largest,v1,v2);
+    }
+    // only the last range of the file can end without a ';'
+    if (finishLEXER(l,&v1,&v2,&weight)){
+        appendTriple(c,v1,v2,weight);
+        widenRange(&c->smallest,&c->largest,v1,v2);
+    }
+    freeLEXER(l);
+    return 0;
+}
+// moves an offset forward to just past the next record separator
+static size_t alignOffset(const char * data,size_t size,size_t offset){
+    if (offset == 0 || offset >= size) return offset;
+    if (data[offset - 1] == ';') return offset;
+    const char * semicolon = memchr(data + offset,';',size - offset);
+    if (semicolon == 0) return size;
+    return semicolon - data + 1;
+}
+static void insertTriples(GRAPH * g,CHUNK * c){
+    int * triple = c->triples;
+    for (size_t e = 0; e < c->count; e++, triple += 3){
+        insertGRAPHedge(g,triple[0],triple[1],triple[2]);
+    }
+}
+// each window is lexed once into a buffer, whose range is hinted before
+// its edges go into the builder
+static void loadSequential(GRAPH * g,MAPPING * m){
+    const char * data = getMAPPINGdata(m);
+    size_t size = sizeMAPPING(m);
+    CHUNK chunk;
+    chunk.triples = 0;
+    chunk.capacity = 0;
+    size_t start = 0;
+    long long edges = 0;
+    while (start < size){
+        size_t stop = (size - start < WINDOW) ? size : alignOffset(data,size,start + WINDOW);
+        chunk.data = data + start;
+        chunk.length = stop - start;
+        lexChunk(&chunk);
+        edges += chunk.count;
+        if (chunk.count > 0) hintGRAPH(g,chunk.smallest,chunk.largest,edges);
+        insertTriples(g,&chunk);
+        releaseMAPPING(m,start,stop - start);
+        start = stop;
+    }
+    free(chunk.triples);
+}
+static void addPosition(BUCKET * b,size_t position){
+    if (b->count == b->capacity){
+        b->capacity = (b->capacity == 0) ? 1024 : b->capacity * 2;
+        b->positions = realloc(b->positions,sizeof(size_t) * b->capacity);
+        assert(b->positions != 0);
+    }
+    b->positions[b->count++] = position;
+}
+// lists the vertex numbers of a lexed range as first seen and buckets its
+// edges by shard
+static void sortChunk(ROUND * r,CHUNK * c){
+    c->seen = newINTERN();
+    if (c->count > 0) hintINTERN(c->seen,c->smallest,c->largest,2 * c->count);
+    for (int s = 0; s < r->shards; s++){
+        c->buckets[s].count = 0;
+    }
+    int * triple = c->triples;
+    for (size_t e = 0; e < c->count; e++, triple += 3){
+        insertINTERN(c->seen,triple[0]);
+        if (triple[0] != triple[1]) insertINTERN(c->seen,triple[1]);
+        addPosition(&c->buckets[shardGRAPHedge(r->g,triple[0],triple[1])],e);
+    }
+    if (c->count > c->keptCapacity){
+        c->keptCapacity = c->count;
+        c->kept = realloc(c->kept,c->keptCapacity);
+        assert(c->kept != 0);
+    }
+}
+static void lexChunks(void * arg,int64_t begin,int64_t end,int worker){
+    ROUND * r = arg;
+    (void)worker;
+    for (int64_t t = begin; t < end; t++){
+        lexChunk(&r->chunks[t]);
+        sortChunk(r,&r->chunks[t]);
+    }
+}
+// each shard goes through the ranges in file order, so the first copy wins
+static void keepEdges(void * arg,int64_t begin,int64_t end,int worker){
+    ROUND * r = arg;
+    (void)worker;
+    for (int64_t s = begin; s < end; s++){
+        for (int t = 0; t < r->ranges; t++){
+            CHUNK * c = &r->chunks[t];
+            BUCKET * b = &c->buckets[s];
+            int64_t placed = 0;
+            for (size_t i = 0; i < b->count; i++){
+                int * triple = c->triples + 3 * b->positions[i];
+                c->kept[b->positions[i]] = keepGRAPHedge(r->g,triple[0],triple[1]);
+                if (c->kept[b->positions[i]] && triple[0] != triple[1]) placed++;
+            }
+            c->placed[s] = placed;
+        }
+    }
+}
+static void placeEdges(void * arg,int64_t begin,int64_t end,int worker){
+    ROUND * r = arg;
+    (void)worker;
+    for (int64_t t = begin; t < end; t++){
+        CHUNK * c = &r->chunks[t];
+        int64_t position = c->position;
+        int * triple = c->triples;
+        for (size_t e = 0; e < c->count; e++, triple += 3){
+            if (!c->kept[e] || triple[0] == triple[1]) continue;
+            setGRAPHedge(r->g,position++,triple[0],triple[1],triple[2]);
+        }
+    }
+}
+// there are as many ranges a round, and shards, as threads
+static void loadParallel(GRAPH * g,MAPPING * m,int threads){
+    const char * data = getMAPPINGdata(m);
+    size_t size = sizeMAPPING(m);
+    POOL * pool = newPOOL(threads);
+    ROUND r;
+    r.g = g;
+    r.ranges = threads;
+    r.shards = threads;
+    r.chunks = calloc(threads,sizeof(CHUNK));
+    assert(r.chunks != 0);
+    for (int t = 0; t < threads; t++){
+        r.chunks[t].buckets = calloc(threads,sizeof(BUCKET));
+        r.chunks[t].placed = calloc(threads,sizeof(int64_t));
+        assert(r.chunks[t].buckets != 0 && r.chunks[t].placed != 0);
+    }
+    shardGRAPH(g,threads);
+    size_t window = (size_t)WINDOW * threads;
+    size_t start = 0;
+    long long edges = 0;
+    while (start < size){
+        size_t stop = (size - start < window) ? size : alignOffset(data,size,start + window);
+        // cut [start,stop) into one range per thread
+        size_t from = start;
+        for (int t = 0; t < threads; t++){
+            size_t to = (t == threads - 1) ? stop : alignOffset(data,stop,start + (stop - start) / threads * (t + 1));
+            if (to < from) to = from;
+            r.chunks[t].data = data + from;
+            r.chunks[t].length = to - from;
+            from = to;
+        }
+        runPOOL(pool,lexChunks,&r,threads);
+        int smallest = INT_MAX;
+        int largest = INT_MIN;
+        for (int t = 0; t < threads; t++){
+            if (r.chunks[t].count == 0) continue;
+            widenRange(&smallest,&largest,r.chunks[t].smallest,r.chunks[t].largest);
+            edges += r.chunks[t].count;
+        }
+        if (smallest <= largest) hintGRAPH(g,smallest,largest,edges);
+        // a vertex first seen in an earlier range keeps the number it got there
+        for (int t = 0; t < threads; t++){
+            int * ids = getINTERNids(r.chunks[t].seen);
+            int count = sizeINTERN(r.chunks[t].seen);
+            for (int i = 0; i < count; i++){
+                addGRAPHvertex(g,ids[i]);
+            }
+            freeINTERN(r.chunks[t].seen);
+        }
+        runPOOL(pool,keepEdges,&r,threads);
+        for (int t = 0; t < threads; t++){
+            int64_t placed = 0;
+            for (int s = 0; s < threads; s++){
+                placed += r.chunks[t].placed[s];
+            }
+            r.chunks[t].position = extendGRAPH(g,placed);
+        }
+        runPOOL(pool,placeEdges,&r,threads);
+        releaseMAPPING(m,start,stop - start);
+        start = stop;
+    }
+    for (int t = 0; t < threads; t++){
+        for (int s = 0; s < threads; s++){
+            free(r.chunks[t].buckets[s].positions);
+        }
+        free(r.chunks[t].buckets);
+        free(r.chunks[t].placed);
+        free(r.chunks[t].kept);
+        free(r.chunks[t].triples);
+    }
+    free(r.chunks);
+    freePOOL(pool);
+}
+static void insertEdge(void * g,int v1,int v2,int weight){
+    insertGRAPHedge(g,v1,v2,weight);
+}
+static int readStream(int fd,void (*edge)(void *,int,int,int),void * arg){
+    char * buffer = malloc(STREAMBUFFER);
+    assert(buffer != 0);
+    LEXER * l = newLEXER();
+    int v1 = 0;
+    int v2 = 0;
+    int weight = 0;
+    int ok = 1;
+    while (1){
+        ssize_t length = read(fd,buffer,STREAMBUFFER);
+        if (length < 0 && errno == EINTR) continue;
+        if (length < 0) ok = 0;
+        if (length <= 0) break;
+        feedLEXER(l,buffer,length);
+        while (readLEXER(l,&v1,&v2,&weight)){
+            edge(arg,v1,v2,weight);
+        }
+    }
+    if (finishLEXER(l,&v1,&v2,&weight)){
+        edge(arg,v1,v2,weight);
+    }
+    freeLEXER(l);
+    free(buffer);
+    return ok;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int loadGRAPH(GRAPH * g,char * filename,int threads){
+    MAPPING * m = (strcmp(filename,"-") == 0) ? 0 : newMAPPING(filename);
+    if (m == 0) return streamEDGES(filename,insertEdge,g);
+    adviseMAPPING(m,MAPPING_SEQUENTIAL);
+    if (threads > 1) loadParallel(g,m,threads);
+    else loadSequential(g,m);
+    freeMAPPING(m);
+    return 1;
+}
+extern int streamEDGES(char * filename,void (*edge)(void *,int,int,int),void * arg){
+    if (strcmp(filename,"-") == 0) return readStream(STDIN_FILENO,edge,arg);
+    int fd = open(filename,O_RDONLY);
+    if (fd < 0) return 0;
+    int ok = readStream(fd,edge,arg);
+    close(fd);
+    return ok;
+}
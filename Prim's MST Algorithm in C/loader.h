@@ -0,0 +1,9 @@
+#ifndef __LOADER_INCLUDED__
+#define __LOADER_INCLUDED__
+
+#include "graph.h"
+
+extern int loadGRAPH(GRAPH *g,char *filename,int threads);
+extern int streamEDGES(char *filename,void (*edge)(void *,int,int,int),void *arg);
+
+#endif
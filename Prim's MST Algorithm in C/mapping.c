@@ -0,0 +1,78 @@
+/*
+ *  A read-only MAPPING of a whole file into memory. The file is never
+ *  copied; pages are faulted in as they are touched and can be handed
+ *  back to the kernel with releaseMAPPING once they have been consumed,
+ *  so a sequential reader keeps a flat memory footprint.
+ *
+ *  newMAPPING returns 0 if the file cannot be opened or mapped.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "mapping.h"
+
+struct mapping{
+    char * data;
+    size_t size;
+};
+
+extern MAPPING *newMAPPING(char * filename){
+    int fd = open(filename,O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat info;
+    if (fstat(fd,&info) != 0 || !S_ISREG(info.st_mode)){
+        close(fd);
+        return 0;
+    }
+    MAPPING * m = malloc(sizeof(MAPPING));
+    assert(m != 0);
+    m->data = 0;
+    m->size = info.st_size;
+    // mmap refuses zero length mappings, an empty file is simply no data
+    if (m->size > 0){
+        void * p = mmap(0,m->size,PROT_READ,MAP_PRIVATE,fd,0);
+        if (p == MAP_FAILED){
+            close(fd);
+            free(m);
+            return 0;
+        }
+        m->data = p;
+    }
+    close(fd);
+    return m;
+}
+extern const char *getMAPPINGdata(MAPPING * m){
+    assert(m != 0);
+    return m->data;
+}
+extern size_t sizeMAPPING(MAPPING * m){
+    assert(m != 0);
+    return m->size;
+}
+extern void adviseMAPPING(MAPPING * m,int advice){
+    assert(m != 0);
+    if (m->size == 0) return;
+    madvise(m->data,m->size,advice == MAPPING_WILLNEED ? MADV_WILLNEED : MADV_SEQUENTIAL);
+}
+// drops the whole pages inside [offset,offset+length), they are refaulted if touched again
+extern void releaseMAPPING(MAPPING * m,size_t offset,size_t length){
+    assert(m != 0);
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t start = (offset + page - 1) / page * page;
+    size_t stop = offset + length;
+    if (stop > m->size) stop = m->size;
+    stop = stop / page * page;
+    if (stop > start) madvise(m->data + start,stop - start,MADV_DONTNEED);
+}
+extern void freeMAPPING(MAPPING * m){
+    assert(m != 0);
+    if (m->data != 0) munmap(m->data,m->size);
+    free((MAPPING *)m);
+}
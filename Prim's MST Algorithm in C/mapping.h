@@ -0,0 +1,18 @@
+#ifndef __MAPPING_INCLUDED__
+#define __MAPPING_INCLUDED__
+
+#include <stddef.h>
+
+#define MAPPING_SEQUENTIAL 0  // read once front to back
+#define MAPPING_WILLNEED 1    // fault the whole file in ahead of use
+
+typedef struct mapping MAPPING;
+
+extern MAPPING *newMAPPING(char *filename);
+extern const char *getMAPPINGdata(MAPPING *m);
+extern size_t sizeMAPPING(MAPPING *m);
+extern void adviseMAPPING(MAPPING *m,int advice);
+extern void releaseMAPPING(MAPPING *m,size_t offset,size_t length);
+extern void freeMAPPING(MAPPING *m);
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ *  A generic PAIRING heap class. When constructed takes the most values it
+ *  will ever hold at once, and function pointers to display, compare,
+ *  update, and free the generic value stored in the heap, the same
+ *  callbacks as the BINOMIAL heap.
+ *
+ *  The heap is one tree. Each node points at its leftmost child and its
+ *  next sibling, and back at its previous sibling, or at its parent if it
+ *  is the leftmost child, so no lists are allocated. Insert and
+ *  decreaseKey meld a single node with the root, extract pairs up the
+ *  children of the root left to right and melds the pairs right to left.
+ *
+ *  Every node comes out of one pool allocated by the constructor and goes
+ *  back to it when its value is extracted, so once the heap is made it
+ *  never calls malloc. Values are never moved between nodes, so the update
+ *  function is never needed here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "pairing.h"
+
+typedef struct pairingnode{
+    void * data;
+    struct pairingnode * child;     // leftmost child
+    struct pairingnode * sibling;   // next sibling to the right
+    struct pairingnode * prev;      // previous sibling, or the parent
+}PairingNODE;
+
+struct pairing{
+    void (*display)(void *,FILE *);
+    int (*compare)(void *,void *);
+    void (*update)(void *,void *);
+    void (*free)(void *);
+    PairingNODE * root;
+    PairingNODE * pool;
+    PairingNODE * released;     // nodes given back, chained through sibling
+    int used;                   // nodes of the pool handed out so far
+    int capacity;
+    int size;
+};
+
+//Constructor
+extern PAIRING *newPAIRING(int capacity,void (*d)(void *,FILE *),int (*c)(void *,void *),void (*s)(void *,void *),void (*f)(void *)){
+    assert(capacity >= 0);
+    PAIRING * created = malloc(sizeof(PAIRING));
+    assert(created != 0);
+    created->display = d;
+    created->compare = c;
+    created->update = s;
+    created->free = f;
+    created->root = 0;
+    created->pool = malloc(sizeof(PairingNODE) * (capacity + 1));
+    assert(created->pool != 0);
+    created->released = 0;
+    created->used = 0;
+    created->capacity = capacity;
+    created->size = 0;
+    return created;
+}
+
+/// Private helper FUNCTIONS ///
+static PairingNODE *takeNODE(PAIRING * p,void * value){
+    PairingNODE * n = p->released;
+    if (n != 0){
+        p->released = n->sibling;
+    }
+    else{
+        assert(p->used < p->capacity);
+        n = &p->pool[p->used];
+        p->used++;
+    }
+    n->data = value;
+    n->child = 0;
+    n->sibling = 0;
+    n->prev = 0;
+    return n;
+}
+static void giveNODE(PAIRING * p,PairingNODE * n){
+    n->data = 0;
+    n->child = 0;
+    n->prev = 0;
+    n->sibling = p->released;
+    p->released = n;
+}
+// a and b are roots of separate trees, returns the root of the two
+static PairingNODE *meld(PAIRING * p,PairingNODE * a,PairingNODE * b){
+    if (a == 0) return b;
+    if (b == 0) return a;
+    if (p->compare(b->data,a->data) < 0){
+        PairingNODE * temp = a;
+        a = b;
+        b = temp;
+    }
+    b->sibling = a->child;
+    if (a->child != 0) a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    return a;
+}
+// takes a node out of its tree along with its subtree
+static void cut(PairingNODE * n){
+    if (n->prev->child == n) n->prev->child = n->sibling;
+    else n->prev->sibling = n->sibling;
+    if (n->sibling != 0) n->sibling->prev = n->prev;
+    n->sibling = 0;
+    n->prev = 0;
+}
+// the two pass pairing of a list of siblings, prev is reused as a stack
+static PairingNODE *mergePairs(PAIRING * p,PairingNODE * first){
+    PairingNODE * pairs = 0;
+    while (first != 0){
+        PairingNODE * a = first;
+        PairingNODE * b = a->sibling;
+        first = (b == 0) ? 0 : b->sibling;
+        a->sibling = 0;
+        a->prev = 0;
+        if (b != 0){
+            b->sibling = 0;
+            b->prev = 0;
+        }
+        a = meld(p,a,b);
+        a->prev = pairs;
+        pairs = a;
+    }
+    PairingNODE * root = 0;
+    while (pairs != 0){
+        PairingNODE * next = pairs->prev;
+        pairs->prev = 0;
+        root = meld(p,root,pairs);
+        pairs = next;
+    }
+    return root;
+}
+static void *removeRoot(PAIRING * p){
+    PairingNODE * r = p->root;
+    p->root = mergePairs(p,r->child);
+    p->size--;
+    void * generic = r->data;
+    giveNODE(p,r);
+    return generic;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void *insertPAIRING(PAIRING * p,void * value){
+    PairingNODE * n = takeNODE(p,value);
+    p->root = meld(p,p->root,n);
+    p->size++;
+    return n;
+}
+extern int sizePAIRING(PAIRING * p){
+    if (p == 0) return 0;
+    return p->size;
+}
+extern int capacityPAIRING(PAIRING * p){
+    assert(p != 0);
+    return p->capacity;
+}
+// the value is removed from the heap but not freed
+extern void deletePAIRING(PAIRING * p,void * node){
+    assert(node != 0);
+    PairingNODE * n = node;
+    if (n != p->root){
+        cut(n);
+        // the subtree of n goes back in without n
+        PairingNODE * rest = mergePairs(p,n->child);
+        p->root = meld(p,p->root,rest);
+        n->child = 0;
+        p->size--;
+        giveNODE(p,n);
+        return;
+    }
+    removeRoot(p);
+}
+extern void decreaseKeyPAIRING(PAIRING * p,void * node,void * value){
+    assert(node != 0);
+    PairingNODE * n = node;
+    n->data = value;
+    if (n == p->root) return;
+    cut(n);
+    p->root = meld(p,p->root,n);
+}
+extern void *peekPAIRING(PAIRING * p){
+    assert(p != 0 && p->root != 0);
+    return p->root->data;
+}
+extern void *extractPAIRING(PAIRING * p){
+    assert(p != 0);
+    if (p->root == 0) return 0;
+    return removeRoot(p);
+}
+extern void statisticsPAIRING(PAIRING * p,FILE * fp){
+    fprintf(fp,"size: %d\n",p->size);
+    fprintf(fp,"pool: %d of %d used\n",p->used,p->capacity);
+    fprintf(fp,"root: ");
+    if (p->root != 0) p->display(p->root->data,fp);
+    else fprintf(fp,"NULL");
+}
+extern void displayPAIRING(PAIRING * p,FILE * fp){
+    if (p->size == 0){
+        fprintf(fp,"EMPTY\n");
+        return;
+    }
+    fprintf(fp,"root: ");
+    p->display(p->root->data,fp);
+    fprintf(fp,"\nchildren: ");
+    for (PairingNODE * ptr = p->root->child; ptr != 0; ptr = ptr->sibling){
+        p->display(ptr->data,fp);
+        if (ptr->sibling != 0) fprintf(fp," ");
+    }
+    fprintf(fp,"\n");
+}
+extern void freePAIRING(PAIRING * p){
+    assert(p != 0);
+    // nodes given back have had their data cleared
+    for (int i = 0; i < p->used; i++){
+        if (p->free != 0 && p->pool[i].data != 0) p->free(p->pool[i].data);
+    }
+    free(p->pool);
+    free((PAIRING *)p);
+}
@@ -0,0 +1,25 @@
+#ifndef __PAIRING_INCLUDED__
+#define __PAIRING_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct pairing PAIRING;
+
+extern PAIRING *newPAIRING(
+        int capacity,
+        void (*display)(void *,FILE *),
+        int (*compare)(void *,void *),
+        void (*update)(void *,void *),
+        void (*free)(void *));
+extern void *insertPAIRING(PAIRING *p,void *value);
+extern int sizePAIRING(PAIRING *p);
+extern int capacityPAIRING(PAIRING *p);
+extern void deletePAIRING(PAIRING *p,void *node);
+extern void decreaseKeyPAIRING(PAIRING *p,void *node,void *value);
+extern void *peekPAIRING(PAIRING *p);
+extern void *extractPAIRING(PAIRING *p);
+extern void statisticsPAIRING(PAIRING *p,FILE *fp);
+extern void displayPAIRING(PAIRING *p,FILE *fp);
+extern void freePAIRING(PAIRING *p);
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ *  A POOL of worker threads for data parallel loops. runPOOL splits the
+ *  items 0..count-1 into one even slice per thread, does the first slice
+ *  on the calling thread and returns once every slice is done, so a job
+ *  is one parallel for loop. The workers sleep on a condition variable
+ *  between jobs and are only started and joined once.
+ *
+ *  If a worker thread cannot be started the pool simply has fewer
+ *  threads.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include "pool.h"
+
+typedef struct poolworker{
+    struct pool * pool;
+    pthread_t thread;
+    int index;
+}POOLWORKER;
+
+struct pool{
+    int threads;
+    POOLWORKER * workers;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    POOLTASK task;
+    void * arg;
+    int64_t count;
+    long generation;    // bumped for every job
+    int finished;       // workers done with the current job
+    int stopping;
+};
+
+/// Private helper FUNCTIONS ///
+static void runSlice(POOL * p,int worker){
+    int64_t begin = p->count * worker / p->threads;
+    int64_t end = p->count * (worker + 1) / p->threads;
+    if (begin < end) p->task(p->arg,begin,end,worker);
+}
+static void *work(void * arg){
+    POOLWORKER * w = arg;
+    POOL * p = w->pool;
+    long seen = 0;
+    pthread_mutex_lock(&p->lock);
+    while (1){
+        while (p->generation == seen && !p->stopping){
+            pthread_cond_wait(&p->start,&p->lock);
+        }
+        if (p->stopping) break;
+        seen = p->generation;
+        pthread_mutex_unlock(&p->lock);
+        runSlice(p,w->index);
+        pthread_mutex_lock(&p->lock);
+        p->finished++;
+        if (p->finished == p->threads - 1) pthread_cond_signal(&p->done);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return 0;
+}
+
+//Constructor
+extern POOL *newPOOL(int threads){
+    assert(threads >= 1);
+    POOL * p = malloc(sizeof(POOL));
+    assert(p != 0);
+    p->workers = malloc(sizeof(POOLWORKER) * threads);
+    assert(p->workers != 0);
+    pthread_mutex_init(&p->lock,0);
+    pthread_cond_init(&p->start,0);
+    pthread_cond_init(&p->done,0);
+    p->generation = 0;
+    p->finished = 0;
+    p->stopping = 0;
+    p->count = 0;
+    // the calling thread is worker 0
+    p->threads = 1;
+    for (int i = 1; i < threads; i++){
+        POOLWORKER * w = &p->workers[p->threads];
+        w->pool = p;
+        w->index = p->threads;
+        if (pthread_create(&w->thread,0,work,w) != 0) break;
+        p->threads++;
+    }
+    return p;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int threadsPOOL(POOL * p){
+    assert(p != 0);
+    return p->threads;
+}
+extern void runPOOL(POOL * p,POOLTASK task,void * arg,int64_t count){
+    assert(p != 0);
+    if (count <= 0) return;
+    pthread_mutex_lock(&p->lock);
+    p->task = task;
+    p->arg = arg;
+    p->count = count;
+    p->finished = 0;
+    p->generation++;
+    pthread_cond_broadcast(&p->start);
+    pthread_mutex_unlock(&p->lock);
+    runSlice(p,0);
+    pthread_mutex_lock(&p->lock);
+    while (p->finished < p->threads - 1){
+        pthread_cond_wait(&p->done,&p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+}
+extern void freePOOL(POOL * p){
+    assert(p != 0);
+    pthread_mutex_lock(&p->lock);
+    p->stopping = 1;
+    pthread_cond_broadcast(&p->start);
+    pthread_mutex_unlock(&p->lock);
+    for (int i = 1; i < p->threads; i++){
+        pthread_join(p->workers[i].thread,0);
+    }
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->start);
+    pthread_cond_destroy(&p->done);
+    free(p->workers);
+    free((POOL *)p);
+}
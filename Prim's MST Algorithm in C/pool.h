@@ -0,0 +1,17 @@
+#ifndef __POOL_INCLUDED__
+#define __POOL_INCLUDED__
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef struct pool POOL;
+
+// does the items begin..end-1 of a job, worker is 0..threads-1
+typedef void (*POOLTASK)(void *arg,int64_t begin,int64_t end,int worker);
+
+extern POOL *newPOOL(int threads);
+extern int threadsPOOL(POOL *p);
+extern void runPOOL(POOL *p,POOLTASK task,void *arg,int64_t count);
+extern void freePOOL(POOL *p);
+
+#endif
@@ -0,0 +1,388 @@
+/*
+ *  The priority queues prim can run on, behind one table of function
+ *  pointers so the engine is picked by name at run time. Every engine is
+ *  driven with vertex indices of the CSR, and the key of a vertex is the
+ *  key its VERTEX holds, so prim sets the key before it inserts or
+ *  decreases.
+ *
+ *      binomial    the BINOMIAL heap, the default
+ *      fibonacci   the FIBONACCI heap
+ *      pairing     the PAIRING heap, one pooled node per vertex
+ *      dary        the indexed DARY heap
+ *      bucket      the BUCKET queue, as bucket or bucket:LIMIT
+ *      lazy        the LAZY binary heap, with no decreaseKey
+ *      sequence    the SEQUENCE heap, with no decreaseKey
+ *
+ *  The three generic heaps hold the VERTEX objects and compare them with
+ *  compareVERTEX. They are seeded with every vertex when they are made, a
+ *  key of -1 sorting last, so inserting a reached vertex only decreases
+ *  its key. The others hold indices and only take a vertex once it has
+ *  been reached. The lazy and sequence heaps push a new entry for a
+ *  decreased key and leave the old one behind, so prim has to skip
+ *  vertices it has already taken out.
+ *
+ *  statisticsPQ reports what the engine knows about the run, the binomial
+ *  heap counting its operations and, when the PQ was made with timing on,
+ *  their cost.
+ *
+ *  decreaseKeyPQbatch decreases the keys of many vertices at once. The
+ *  binomial heap does them in one decreaseKeyBINOMIALbatch, the others
+ *  one at a time. The keys of the vertices in a batch are all set before
+ *  it is handed over, which only the binomial batch allows for, so prim
+ *  asks batchedPQ and decreases one key at a time for the others, each
+ *  right after it is set. For a seeded engine the first key a vertex gets
+ *  is a decrease too, seededPQ tells prim so.
+ *
+ *  The bucket queue keeps one bucket per weight. newPQ returns 0 for it
+ *  when a weight is negative or not below the limit, 65536 by default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "pq.h"
+#include "binomial.h"
+#include "fibonacci.h"
+#include "pairing.h"
+#include "dary.h"
+#include "bucket.h"
+#include "lazy.h"
+#include "sequence.h"
+
+#define BUCKETLIMIT (1 << 16)
+
+typedef struct pqengine{
+    char * name;
+    int (*make)(PQ *);
+    void (*insert)(PQ *,int vertex,int key);
+    void (*decreaseKey)(PQ *,int vertex,int key);
+    int (*extract)(PQ *);
+    int (*size)(PQ *);
+    void (*free)(PQ *);
+    void (*statistics)(PQ *,FILE *);
+    void (*batch)(PQ *,int * vertices,int n);   // 0 to decrease one by one
+    int seeded;     // holds every vertex from the start
+}PQENGINE;
+
+struct pq{
+    const PQENGINE * engine;
+    void * queue;
+    CSR * graph;
+    VERTEX ** vertices;
+    int limit;      // the bucket limit
+    int timing;     // engines that can time their operations should
+    void ** nodes;  // scratch for the binomial batch
+    void ** values;
+};
+
+/// Private helper FUNCTIONS ///
+static void updateOwner(void * v,void * n){
+    setVERTEXowner(v,n);
+}
+static VERTEX *vertexPQ(PQ * q,int vertex){
+    return q->vertices[vertex];
+}
+
+//// binomial ////
+static int makeBinomial(PQ * q){
+    BINOMIAL * b = newBINOMIAL(displayVERTEXdebug,compareVERTEX,updateOwner,0);
+    setBINOMIALtiming(b,q->timing);
+    buildBINOMIAL(b,(void **)q->vertices,sizeCSR(q->graph));
+    q->queue = b;
+    return 1;
+}
+static void decreaseBinomial(PQ * q,int vertex,int key){
+    (void)key;
+    VERTEX * v = vertexPQ(q,vertex);
+    decreaseKeyBINOMIAL(q->queue,getVERTEXowner(v),v);
+}
+static int extractBinomial(PQ * q){
+    return getVERTEXindex(extractBINOMIAL(q->queue));
+}
+static int sizeBinomial(PQ * q){
+    return sizeBINOMIAL(q->queue);
+}
+static void freeBinomial(PQ * q){
+    freeBINOMIAL(q->queue);
+}
+static void batchBinomial(PQ * q,int * vertices,int n){
+    if (q->nodes == 0){
+        q->nodes = malloc(sizeof(void *) * (sizeCSR(q->graph) + 1));
+        q->values = malloc(sizeof(void *) * (sizeCSR(q->graph) + 1));
+        assert(q->nodes != 0 && q->values != 0);
+    }
+    for (int i = 0; i < n; i++){
+        VERTEX * v = vertexPQ(q,vertices[i]);
+        q->nodes[i] = getVERTEXowner(v);
+        q->values[i] = v;
+    }
+    decreaseKeyBINOMIALbatch(q->queue,q->nodes,q->values,n);
+}
+static void statisticsBinomial(PQ * q,FILE * fp){
+    statisticsBINOMIAL(q->queue,fp);
+    fprintf(fp,"\n");
+}
+
+//// fibonacci ////
+static int makeFibonacci(PQ * q){
+    FIBONACCI * f = newFIBONACCI(displayVERTEXdebug,compareVERTEX,updateOwner,0);
+    for (int i = 0; i < sizeCSR(q->graph); i++){
+        setVERTEXowner(q->vertices[i],insertFIBONACCI(f,q->vertices[i]));
+    }
+    q->queue = f;
+    return 1;
+}
+static void decreaseFibonacci(PQ * q,int vertex,int key){
+    (void)key;
+    VERTEX * v = vertexPQ(q,vertex);
+    decreaseKeyFIBONACCI(q->queue,getVERTEXowner(v),v);
+}
+static int extractFibonacci(PQ * q){
+    return getVERTEXindex(extractFIBONACCI(q->queue));
+}
+static int sizeFibonacci(PQ * q){
+    return sizeFIBONACCI(q->queue);
+}
+static void freeFibonacci(PQ * q){
+    freeFIBONACCI(q->queue);
+}
+static void statisticsFibonacci(PQ * q,FILE * fp){
+    statisticsFIBONACCI(q->queue,fp);
+    fprintf(fp,"\n");
+}
+
+//// pairing ////
+static int makePairing(PQ * q){
+    PAIRING * p = newPAIRING(sizeCSR(q->graph),displayVERTEXdebug,compareVERTEX,updateOwner,0);
+    for (int i = 0; i < sizeCSR(q->graph); i++){
+        setVERTEXowner(q->vertices[i],insertPAIRING(p,q->vertices[i]));
+    }
+    q->queue = p;
+    return 1;
+}
+static void decreasePairing(PQ * q,int vertex,int key){
+    (void)key;
+    VERTEX * v = vertexPQ(q,vertex);
+    decreaseKeyPAIRING(q->queue,getVERTEXowner(v),v);
+}
+static int extractPairing(PQ * q){
+    return getVERTEXindex(extractPAIRING(q->queue));
+}
+static int sizePairing(PQ * q){
+    return sizePAIRING(q->queue);
+}
+static void freePairing(PQ * q){
+    freePAIRING(q->queue);
+}
+static void statisticsPairing(PQ * q,FILE * fp){
+    statisticsPAIRING(q->queue,fp);
+    fprintf(fp,"\n");
+}
+
+//// dary ////
+static int makeDary(PQ * q){
+    q->queue = newDARY(sizeCSR(q->graph),getCSRids(q->graph));
+    return 1;
+}
+static void insertDary(PQ * q,int vertex,int key){
+    insertDARY(q->queue,vertex,key);
+}
+static void decreaseDary(PQ * q,int vertex,int key){
+    decreaseKeyDARY(q->queue,vertex,key);
+}
+static int extractDary(PQ * q){
+    return extractDARY(q->queue);
+}
+static int sizeDary(PQ * q){
+    return sizeDARY(q->queue);
+}
+static void freeDary(PQ * q){
+    freeDARY(q->queue);
+}
+static void statisticsDary(PQ * q,FILE * fp){
+    fprintf(fp,"size: %d\n",sizeDARY(q->queue));
+    fprintf(fp,"arity: %d\n",arityDARY());
+}
+
+//// bucket ////
+// one bucket per weight, none if the weights do not fit under the limit
+static int makeBucket(PQ * q){
+    CSRARC * arcs = getCSRarcs(q->graph);
+    int largest = 0;
+    for (int64_t a = 0; a < arcsCSR(q->graph); a++){
+        if (arcs[a].weight < 0 || arcs[a].weight >= q->limit) return 0;
+        if (arcs[a].weight > largest) largest = arcs[a].weight;
+    }
+    q->queue = newBUCKET(sizeCSR(q->graph),largest + 1);
+    return 1;
+}
+static void insertBucket(PQ * q,int vertex,int key){
+    insertBUCKET(q->queue,vertex,key);
+}
+static void decreaseBucket(PQ * q,int vertex,int key){
+    decreaseKeyBUCKET(q->queue,vertex,key);
+}
+static int extractBucket(PQ * q){
+    return extractBUCKET(q->queue);
+}
+static int sizeBucket(PQ * q){
+    return sizeBUCKET(q->queue);
+}
+static void freeBucket(PQ * q){
+    freeBUCKET(q->queue);
+}
+static void statisticsBucket(PQ * q,FILE * fp){
+    fprintf(fp,"size: %d\n",sizeBUCKET(q->queue));
+}
+
+//// lazy ////
+static int makeLazy(PQ * q){
+    q->queue = newLAZY(sizeCSR(q->graph),getCSRids(q->graph));
+    return 1;
+}
+static void pushLazy(PQ * q,int vertex,int key){
+    pushLAZY(q->queue,vertex,key);
+}
+static int extractLazy(PQ * q){
+    return popLAZY(q->queue,0);
+}
+static int sizeLazy(PQ * q){
+    int64_t size = sizeLAZY(q->queue);
+    return (size > INT_MAX) ? INT_MAX : size;
+}
+static void freeLazy(PQ * q){
+    freeLAZY(q->queue);
+}
+static void statisticsLazy(PQ * q,FILE * fp){
+    fprintf(fp,"size: %lld\n",(long long)sizeLAZY(q->queue));
+}
+
+//// sequence ////
+static int makeSequence(PQ * q){
+    q->queue = newSEQUENCE(getCSRids(q->graph));
+    return 1;
+}
+static void pushSequence(PQ * q,int vertex,int key){
+    pushSEQUENCE(q->queue,vertex,key);
+}
+static int extractSequence(PQ * q){
+    return popSEQUENCE(q->queue,0);
+}
+static int sizeSequence(PQ * q){
+    int64_t size = sizeSEQUENCE(q->queue);
+    return (size > INT_MAX) ? INT_MAX : size;
+}
+static void freeSequence(PQ * q){
+    freeSEQUENCE(q->queue);
+}
+static void statisticsSequence(PQ * q,FILE * fp){
+    statisticsSEQUENCE(q->queue,fp);
+    fprintf(fp,"\n");
+}
+
+// the seeded heaps already hold every vertex, so an insert is a decrease
+static const PQENGINE engines[] = {
+    {"binomial",makeBinomial,decreaseBinomial,decreaseBinomial,extractBinomial,sizeBinomial,freeBinomial,statisticsBinomial,batchBinomial,1},
+    {"fibonacci",makeFibonacci,decreaseFibonacci,decreaseFibonacci,extractFibonacci,sizeFibonacci,freeFibonacci,statisticsFibonacci,0,1},
+    {"pairing",makePairing,decreasePairing,decreasePairing,extractPairing,sizePairing,freePairing,statisticsPairing,0,1},
+    {"dary",makeDary,insertDary,decreaseDary,extractDary,sizeDary,freeDary,statisticsDary,0,0},
+    {"bucket",makeBucket,insertBucket,decreaseBucket,extractBucket,sizeBucket,freeBucket,statisticsBucket,0,0},
+    {"lazy",makeLazy,pushLazy,pushLazy,extractLazy,sizeLazy,freeLazy,statisticsLazy,0,0},
+    {"sequence",makeSequence,pushSequence,pushSequence,extractSequence,sizeSequence,freeSequence,statisticsSequence,0,0},
+};
+#define ENGINES ((int)(sizeof(engines) / sizeof(engines[0])))
+
+// finds the engine named before any ':', setting the limit given after it
+static const PQENGINE *findEngine(char * name,int * limit){
+    size_t length = strcspn(name,":");
+    for (int i = 0; i < ENGINES; i++){
+        if (strlen(engines[i].name) != length || strncmp(engines[i].name,name,length) != 0) continue;
+        if (name[length] == ':'){
+            if (engines[i].make != makeBucket) return 0;
+            *limit = atoi(name + length + 1);
+            if (*limit < 1) return 0;
+        }
+        return &engines[i];
+    }
+    return 0;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int isPQengine(char * engine){
+    int limit = BUCKETLIMIT;
+    return findEngine(engine,&limit) != 0;
+}
+extern void displayPQengines(FILE * fp){
+    for (int i = 0; i < ENGINES; i++){
+        if (i > 0) fprintf(fp," ");
+        fprintf(fp,"%s",engines[i].name);
+    }
+}
+// returns 0 if there is no such engine or it cannot hold the graph's weights
+extern PQ *newPQ(char * engine,CSR * graph,VERTEX ** vertices,int timing){
+    PQ * q = malloc(sizeof(PQ));
+    assert(q != 0);
+    q->limit = BUCKETLIMIT;
+    q->engine = findEngine(engine,&q->limit);
+    q->queue = 0;
+    q->graph = graph;
+    q->vertices = vertices;
+    q->timing = timing;
+    q->nodes = 0;
+    q->values = 0;
+    if (q->engine == 0 || q->engine->make(q) == 0){
+        free((PQ *)q);
+        return 0;
+    }
+    return q;
+}
+extern char *namePQ(PQ * q){
+    assert(q != 0);
+    return q->engine->name;
+}
+extern void insertPQ(PQ * q,int vertex){
+    q->engine->insert(q,vertex,getVERTEXkey(q->vertices[vertex]));
+}
+extern void decreaseKeyPQ(PQ * q,int vertex){
+    q->engine->decreaseKey(q,vertex,getVERTEXkey(q->vertices[vertex]));
+}
+// every vertex must already be in the queue and be given once
+extern void decreaseKeyPQbatch(PQ * q,int * vertices,int n){
+    if (q->engine->batch != 0){
+        q->engine->batch(q,vertices,n);
+        return;
+    }
+    for (int i = 0; i < n; i++){
+        decreaseKeyPQ(q,vertices[i]);
+    }
+}
+// whether decreaseKeyPQbatch does better than one decrease at a time
+extern int batchedPQ(PQ * q){
+    assert(q != 0);
+    return q->engine->batch != 0;
+}
+extern int seededPQ(PQ * q){
+    assert(q != 0);
+    return q->engine->seeded;
+}
+extern int extractPQ(PQ * q){
+    return q->engine->extract(q);
+}
+extern int sizePQ(PQ * q){
+    if (q == 0) return 0;
+    return q->engine->size(q);
+}
+extern void statisticsPQ(PQ * q,FILE * fp){
+    assert(q != 0);
+    fprintf(fp,"priority queue: %s\n",q->engine->name);
+    q->engine->statistics(q,fp);
+}
+extern void freePQ(PQ * q){
+    assert(q != 0);
+    q->engine->free(q);
+    free(q->nodes);
+    free(q->values);
+    free((PQ *)q);
+}
@@ -0,0 +1,24 @@
+#ifndef __PQ_INCLUDED__
+#define __PQ_INCLUDED__
+
+#include <stdio.h>
+#include "csr.h"
+#include "vertex.h"
+
+typedef struct pq PQ;
+
+extern int isPQengine(char *engine);
+extern void displayPQengines(FILE *fp);
+extern PQ *newPQ(char *engine,CSR *graph,VERTEX **vertices,int timing);
+extern char *namePQ(PQ *q);
+extern void insertPQ(PQ *q,int vertex);
+extern void decreaseKeyPQ(PQ *q,int vertex);
+extern void decreaseKeyPQbatch(PQ *q,int *vertices,int n);
+extern int batchedPQ(PQ *q);
+extern int seededPQ(PQ *q);
+extern int extractPQ(PQ *q);
+extern int sizePQ(PQ *q);
+extern void statisticsPQ(PQ *q,FILE *fp);
+extern void freePQ(PQ *q);
+
+#endif
@@ -9,11 +9,73 @@
  *  the INTEGER class for the numbers: 2 numbers describing 
  *  the value of the vertices with the 3rd number being the weight 
  *  of the edge between the two vertices.
- *  If a 3rd number is not given, it will default the weight as 0.
+ *  If a 3rd number is not given, it will default the weight as 1.
  *
  *  Ex: 1 3 4 ; 1 2 ;
  *  The above file would read in as vertices: 1,3,2 with weights of
- *  4 and 0 respectively.
+ *  4 and 1 respectively.
+ *
+ *  The file is memory mapped and tokenized in place (see lexer.c), so
+ *  no memory is allocated per token however large the file is.
+ *
+ *  A graph that is read often can be converted once into a binary graph
+ *  file (see csr.c) with:  prim -c graph.txt graph.csr
+ *  Binary graph files are recognized by prim and loaded with no parsing.
+ *
+ *  A large text graph can be read with several threads, as in
+ *  prim -t 8 graph.txt  (see loader.c).
+ *
+ *  Prim runs on a binomial heap unless another priority queue is picked
+ *  by name with -q (see pq.c), as in  prim -q pairing graph.txt
+ *  The engines are binomial, fibonacci, pairing, dary, bucket, lazy and
+ *  sequence.
+ *  The bucket queue keeps one bucket per weight and takes a limit on the
+ *  weights, as in -q bucket:4096. When a weight does not fit, prim falls
+ *  back to the binomial heap. Buckets do not break ties on the vertex
+ *  number, so with equal weights -q bucket may print a different tree of
+ *  the same weight. The lazy heap has no decreaseKey, improved keys are
+ *  pushed again and the stale entries skipped. The sequence heap works
+ *  the same way but keeps its entries in sorted runs that are only ever
+ *  scanned, for graphs too big for the cache.
+ *
+ *  -m kruskal finds the tree with kruskal's algorithm (see kruskal.c)
+ *  instead of prim's. The tree is then hung from the source vertex so it
+ *  prints the same way. Among edges of equal weight kruskal may pick a
+ *  different tree than prim does, of the same weight.
+ *
+ *  -m filter finds the same tree as -m kruskal with filter kruskal, which
+ *  only sorts the edges that could still join two trees, partitioning
+ *  and filtering the edges on -t threads. It pays off when there are many
+ *  more edges than vertices.
+ *
+ *  -m boruvka finds it with boruvka's algorithm on -t threads (see
+ *  boruvka.c), contracting the graph a round at a time, and prints it the
+ *  same way. With -s the time of each round goes to stderr.
+ *
+ *  -f prints a minimum spanning forest, one tree for every component of
+ *  the graph rather than only the source vertex's (see components.c),
+ *  numbered in the order of their first vertex and followed by the weight
+ *  of the whole forest. With prim each component gets a queue and a run
+ *  of prim of its own, the components being shared out largest first
+ *  among -t threads. -s is ignored with prim then. The other algorithms
+ *  find a forest anyway, it is hung from the first vertex of every
+ *  component.
+ *
+ *  -u updates keeps the tree up to date as new edges come in (see
+ *  dynmst.c), as in  generator | prim -u - graph.txt  The graph is read
+ *  and its forest found, then every edge of the updates file, in the same
+ *  format, is applied as soon as it has been read. A new edge is inserted,
+ *  an edge that is already there takes the new weight and a negative
+ *  weight deletes the edge. A line is printed for each update, saying what
+ *  it did to the tree, with the weight of the forest after it.
+ *
+ *  -s prints the statistics of the priority queue to stderr once prim is
+ *  done. The binomial heap reports how many of each operation it did,
+ *  the comparisons, the levels climbed by decreaseKey, the longest root
+ *  list and the time spent in each kind of operation.
+ *
+ *  The file - is standard input, so a graph can also be piped in as it is
+ *  generated:  generator | prim -  Pipes are read as a stream.
  *
  *  The program reads the file as an undirected graph and executes on
  *  positive INTEGERS only.
@@ -33,40 +95,34 @@
 #include "integer.h"
 #include "real.h"
 #include "string.h"
-#include "scanner.h"
-#include "avl.h"
 #include "queue.h"
 #include "binomial.h"
+#include "pq.h"
+#include "kruskal.h"
+#include "boruvka.h"
+#include "pool.h"
+#include "components.h"
+#include "dynmst.h"
+#include "intern.h"
 #include "vertex.h"
-#include "edge.h"
+#include "csr.h"
+#include "graph.h"
+#include "loader.h"
 
 /* options */
-int g = 0;    /* option -g*/
-int r = 0;    /* option -r default */
 int v = 0;    /* option -v*/
+int c = 0;    /* option -c*/
+int t = 1;    /* option -t, threads used to read a text graph */
+char * q = "binomial";    /* option -q, the priority queue prim runs on */
+int s = 0;    /* option -s, print the priority queue statistics to stderr */
+char * m = "prim";    /* option -m, the minimum spanning tree algorithm */
+int f = 0;    /* option -f, a spanning tree for every component */
+char * u = 0;    /* option -u, edges to insert one at a time once the graph is read */
 // globabl variable
 
 static int processOptions(int,int,char **);
 void Fatal(char *,...);
 
-// returns true if string is empty and shouldn't be inserted
-int isSemiColon (char * string){
-    if (string == 0) return 0;
-    if (strcmp(string,";") == 0) return 1;
-    return 0;
-}
-
-char * readFunct (FILE * fpIN){
-    char * string;
-    if (stringPending(fpIN)){
-        string = readString(fpIN);
-    }
-    else{
-        string = readToken(fpIN);
-    }
-    return string;
-}
-
 static void
 update(void *v,void *n) //v is a vertex, n is a binomial heap node
 {
@@ -79,59 +135,202 @@ compareVERTEXprint (void * x, void * y){
     VERTEX * b = y;
     int aNum = getVERTEXnumber(a);
     int bNum = getVERTEXnumber(b);
-    return (aNum-bNum);
+    return (aNum > bNum) - (aNum < bNum);
+}
+
+// reads either a binary graph file or a text edge list
+static CSR *readGraph(char * filename){
+    if (isCSRfile(filename)){
+        CSR * graph = loadCSR(filename);
+        if (graph == 0) Fatal("%s is not a valid binary graph file\n",filename);
+        return graph;
+    }
+    // duplicate edges and vertices are dropped as the graph is built
+    GRAPH * builder = newGRAPH();
+    if (loadGRAPH(builder,filename,t) == 0) Fatal("could not read %s\n",filename);
+    CSR * graph = getGRAPHcsr(builder);
+    freeGRAPH(builder);
+    return graph;
 }
 
-void PrimFunct(BINOMIAL * Q,VERTEX * sv){
+void PrimFunct(PQ * Q,CSR * graph,VERTEX ** vertices,VERTEX * sv){
     if (sv == 0) return;
     // decrease original key
     setVERTEXkey(sv,0);
     setVERTEXpred(sv,0);
-    decreaseKeyBINOMIAL(Q,getVERTEXowner(sv),sv);
+    insertPQ(Q,getVERTEXindex(sv));
     
     VERTEX * u = 0;
     VERTEX * v = 0;
-    DLL * weightList = 0;
-    DLL * neighborList = 0;
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
     int weight = 0;
-    while (sizeBINOMIAL(Q) != 0){
-        u = extractBINOMIAL(Q);
+    // the keys one vertex decreases are handed to a queue that can batch
+    // them together, any other queue has to see each key as it changes
+    int * decreased = malloc(sizeof(int) * (sizeCSR(graph) + 1));
+    assert(decreased != 0);
+    int seeded = seededPQ(Q);
+    int batched = batchedPQ(Q);
+    while (sizePQ(Q) != 0){
+        int index = extractPQ(Q);
+        u = vertices[index];
         //printf("U->"); displayVERTEXdebug(u,stdout); printf("\n");
+        // only the lazy heaps hand out a vertex a second time, with a stale key
+        if (getVERTEXflag(u) == 1) continue;
         setVERTEXflag(u,1);
-        neighborList = getVERTEXneighbors(u);
-        weightList = getVERTEXweights(u);
-        firstDLL(neighborList);
-        firstDLL(weightList);
-        while (moreDLL(neighborList) != 0){
+        int count = 0;
+        for (int64_t a = offsets[index]; a < offsets[index + 1]; a++){
             //printf("running through the neighbors\n");
-            v = currentDLL(neighborList);
-            weight = getINTEGER((INTEGER *)currentDLL(weightList));
+            v = vertices[arcs[a].vertex];
+            weight = arcs[a].weight;
             if (getVERTEXflag(v) != 1 && ((getVERTEXkey(v) == -1) || (getVERTEXkey(v) > weight))){
+                // a key of -1 means the vertex has not been reached yet
+                int reached = getVERTEXkey(v) != -1;
                 setVERTEXpred(v,u);
                 setVERTEXkey(v,weight);
-                decreaseKeyBINOMIAL(Q,getVERTEXowner(v),v);
+                if (!reached && !seeded) insertPQ(Q,arcs[a].vertex);
+                else if (batched) decreased[count++] = arcs[a].vertex;
+                else decreaseKeyPQ(Q,arcs[a].vertex);
             }
-            nextDLL(neighborList);
-            nextDLL(weightList);
         }
+        if (count > 0) decreaseKeyPQbatch(Q,decreased,count);
     }
+    free(decreased);
 }
 
-void PrintFunction (VERTEX * sv){
+// hangs a spanning forest from sv, setting pred and key as prim would
+// every other tree of the forest is hung from its first vertex
+static void orientTree(int size,VERTEX ** vertices,VERTEX * sv,MSTEDGE * tree,int count){
+    // the tree as adjacency lists, the neighbors of i are at start[i]..start[i+1]
+    int * start = calloc(size + 1,sizeof(int));
+    int * neighbor = malloc(sizeof(int) * (2 * count + 1));
+    int * weight = malloc(sizeof(int) * (2 * count + 1));
+    int * queue = malloc(sizeof(int) * (size + 1));
+    assert(start != 0 && neighbor != 0 && weight != 0 && queue != 0);
+    for (int e = 0; e < count; e++){
+        start[tree[e].v1 + 1]++;
+        start[tree[e].v2 + 1]++;
+    }
+    for (int i = 0; i < size; i++){
+        start[i + 1] += start[i];
+    }
+    for (int e = 0; e < count; e++){
+        neighbor[start[tree[e].v1]] = tree[e].v2;
+        weight[start[tree[e].v1]++] = tree[e].weight;
+        neighbor[start[tree[e].v2]] = tree[e].v1;
+        weight[start[tree[e].v2]++] = tree[e].weight;
+    }
+    for (int i = size; i > 0; i--){
+        start[i] = start[i - 1];
+    }
+    start[0] = 0;
+    // breadth first from the source, flag marks the vertices reached
+    for (int root = -1; root < size; root++){
+        VERTEX * r = (root == -1) ? sv : vertices[root];
+        if (getVERTEXflag(r) == 1) continue;
+        setVERTEXkey(r,0);
+        setVERTEXpred(r,0);
+        setVERTEXflag(r,1);
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = getVERTEXindex(r);
+        while (head < tail){
+            int u = queue[head++];
+            for (int a = start[u]; a < start[u + 1]; a++){
+                VERTEX * v = vertices[neighbor[a]];
+                if (getVERTEXflag(v) == 1) continue;
+                setVERTEXflag(v,1);
+                setVERTEXpred(v,vertices[u]);
+                setVERTEXkey(v,weight[a]);
+                queue[tail++] = neighbor[a];
+            }
+        }
+    }
+    free(start);
+    free(neighbor);
+    free(weight);
+    free(queue);
+}
+
+typedef struct primforest{
+    COMPONENTS * components;
+    CSR * graph;
+    VERTEX ** vertices;
+    int next;           // the next component to be claimed, largest first
+    int fellBack;       // a component's weights did not fit the queue asked for
+}PRIMFOREST;
+
+// runs prim on a component copied out into a CSR of its own
+static void primComponent(PRIMFOREST * p,int k){
+    int size = sizeCOMPONENTS(p->components,k);
+    int * members = getCOMPONENTSmembers(p->components,k);
+    if (size == 1){
+        VERTEX * only = p->vertices[members[0]];
+        setVERTEXkey(only,0);
+        setVERTEXpred(only,0);
+        setVERTEXflag(only,1);
+        return;
+    }
+    CSR * component = getCOMPONENTScsr(p->components,p->graph,k);
+    VERTEX ** local = malloc(sizeof(VERTEX *) * size);
+    assert(local != 0);
+    // the queues find a vertex by its index, which is the local one meanwhile
+    for (int i = 0; i < size; i++){
+        local[i] = p->vertices[members[i]];
+        setVERTEXindex(local[i],i);
+    }
+    PQ * Q = newPQ(q,component,local,0);
+    if (Q == 0){
+        __atomic_store_n(&p->fellBack,1,__ATOMIC_RELAXED);
+        Q = newPQ("binomial",component,local,0);
+    }
+    assert(Q != 0);
+    PrimFunct(Q,component,local,local[0]);
+    freePQ(Q);
+    for (int i = 0; i < size; i++){
+        setVERTEXindex(local[i],members[i]);
+    }
+    free(local);
+    freeCSR(component);
+}
+// one item per worker, each claiming components until there are none left
+static void primComponents(void * arg,int64_t begin,int64_t end,int worker){
+    PRIMFOREST * p = arg;
+    (void)begin;
+    (void)end;
+    (void)worker;
+    int * order = getCOMPONENTSorder(p->components);
+    while (1){
+        int next = __atomic_fetch_add(&p->next,1,__ATOMIC_RELAXED);
+        if (next >= countCOMPONENTS(p->components)) return;
+        primComponent(p,order[next]);
+    }
+}
+static void PrimForest(COMPONENTS * components,CSR * graph,VERTEX ** vertices){
+    PRIMFOREST p = {components,graph,vertices,0,0};
+    POOL * pool = newPOOL(t);
+    runPOOL(pool,primComponents,&p,threadsPOOL(pool));
+    freePOOL(pool);
+    if (p.fellBack) fprintf(stderr,"weights do not fit the %s queue, using the binomial heap\n",q);
+}
+
+int PrintFunction (CSR * graph,VERTEX ** vertices,VERTEX * sv){
     if (sv == 0){
         printf("EMPTY\n");
     }
     //Create an empty QUEUE//
     QUEUE * vertexList = newQUEUE(0,0);
     BINOMIAL * printHEAP = newBINOMIAL(displayVERTEX,compareVERTEXprint,update,freeVERTEX);
+    // each level is inserted whole before any of it is extracted
+    setBINOMIALlazy(printHEAP,1);
     //Enqueue the source vertex and initialize the height//
     enqueue(vertexList,sv);
     
     VERTEX * ptr = 0;
     VERTEX * v = 0;
     int weight = 0;
-    DLL * neighborList = 0;
-    DLL * weightList = 0;
+    int64_t * offsets = getCSRoffsets(graph);
+    CSRARC * arcs = getCSRarcs(graph);
     int nodesAtLevel = sizeQUEUE(vertexList);
     int levelNum = 0;
     int totalWeight = 0;
@@ -141,20 +340,15 @@ void PrintFunction (VERTEX * sv){
             // insert the dequeued vertex
             setVERTEXowner(ptr,insertBINOMIAL(printHEAP,ptr));
             // walk through the list and add only its neighbors that point back to it
-            neighborList = getVERTEXneighbors(ptr);
-            weightList = getVERTEXweights(ptr);
-            firstDLL(neighborList);
-            firstDLL(weightList);
-            while (moreDLL(neighborList) != 0){
-                v = currentDLL(neighborList);
-                weight = getINTEGER(currentDLL(weightList));
+            int index = getVERTEXindex(ptr);
+            for (int64_t a = offsets[index]; a < offsets[index + 1]; a++){
+                v = vertices[arcs[a].vertex];
+                weight = arcs[a].weight;
                 // enqueue for the next stuff
                 if (getVERTEXpred(v) == ptr){
                     setVERTEXkey(v,weight);
                     enqueue(vertexList,v);
                 }
-                nextDLL(neighborList);
-                nextDLL(weightList);
             }
         }
         // print the previous heap in order
@@ -176,7 +370,82 @@ void PrintFunction (VERTEX * sv){
         nodesAtLevel = sizeQUEUE(vertexList);
     }
     printf("weight: %d\n",totalWeight);
+    return totalWeight;
+}
+static void PrintForest(COMPONENTS * components,CSR * graph,VERTEX ** vertices){
+    long long forestWeight = 0;
+    for (int k = 0; k < countCOMPONENTS(components); k++){
+        printf("component %d: %d vertices\n",k + 1,sizeCOMPONENTS(components,k));
+        forestWeight += PrintFunction(graph,vertices,vertices[getCOMPONENTSmembers(components,k)[0]]);
+    }
+    printf("forest weight: %lld\n",forestWeight);
 }
+typedef struct updates{
+    DYNMST * forest;
+    INTERN * numbers;   // vertex number to vertex index of the forest
+}UPDATES;
+
+static int updateVertex(UPDATES * updates,int number){
+    int index = insertINTERN(updates->numbers,number);
+    if (index == sizeDYNMST(updates->forest)) addDYNMSTvertex(updates->forest);
+    return index;
+}
+static void printUpdateEdge(UPDATES * updates,MSTEDGE * e){
+    printf("%d %d %d",getINTERNid(updates->numbers,e->v1),getINTERNid(updates->numbers,e->v2),e->weight);
+}
+// a negative weight deletes the edge, any other inserts or reweights it
+static void applyUpdate(void * arg,int v1,int v2,int weight){
+    UPDATES * updates = arg;
+    MSTEDGE other;
+    int result = DYNMST_MISSING;
+    if (weight >= 0){
+        result = insertDYNMSTedge(updates->forest,updateVertex(updates,v1),updateVertex(updates,v2),weight,&other);
+    }
+    else if (findINTERN(updates->numbers,v1) != -1 && findINTERN(updates->numbers,v2) != -1){
+        result = deleteDYNMSTedge(updates->forest,findINTERN(updates->numbers,v1),findINTERN(updates->numbers,v2),&other);
+    }
+    printf("%d %d %d: ",v1,v2,weight);
+    switch (result){
+        case DYNMST_JOINED:
+            printf("joins two trees");
+            break;
+        case DYNMST_REPLACED:
+            printf("replaces ");
+            printUpdateEdge(updates,&other);
+            break;
+        case DYNMST_SUBSTITUTED:
+            printf("replaced by ");
+            printUpdateEdge(updates,&other);
+            break;
+        case DYNMST_SPLIT:
+            printf("splits a tree");
+            break;
+        case DYNMST_MISSING:
+            printf("no such edge");
+            break;
+        default:
+            printf("same tree edges");
+    }
+    printf(", weight: %lld\n",weightDYNMST(updates->forest));
+    // whoever is sending the updates may be waiting for the answer
+    fflush(stdout);
+}
+void UpdateFunction(CSR * graph,char * filename){
+    UPDATES updates;
+    updates.forest = newDYNMST(sizeCSR(graph));
+    updates.numbers = newINTERN();
+    int * ids = getCSRids(graph);
+    for (int i = 0; i < sizeCSR(graph); i++){
+        insertINTERN(updates.numbers,ids[i]);
+    }
+    buildDYNMST(updates.forest,graph);
+    printf("weight: %lld\n",weightDYNMST(updates.forest));
+    fflush(stdout);
+    if (streamEDGES(filename,applyUpdate,&updates) == 0) Fatal("could not read %s\n",filename);
+    freeINTERN(updates.numbers);
+    freeDYNMST(updates.forest);
+}
+
 int
 main(int argc,char **argv){
     
@@ -189,116 +458,89 @@ main(int argc,char **argv){
         return 0;
     }
     
-    // Initialize Variables
-    char * file1 = 0;
-    char * fileString = 0;
-    int count = 0;
-    EDGE * edge = 0;
-    // Source vertex
-    VERTEX * sourceVertex = 0;
-    int toggle = 0;
-    VERTEX * v1 = 0;
-    VERTEX * v2 = 0;
-    int weight = 1;
-    int length = 2;
-    int * vertices = malloc(sizeof(int) * length);
-    vertices[0] = 0;
-    vertices[1] = 0;
     /* No corpus or command files */
     if (argIndex == argc) {
         return 0;
     }
-    file1 = argv[argIndex];
-    FILE * fpIN1 = 0;
-    BINOMIAL * b = newBINOMIAL(displayVERTEXdebug,compareVERTEX,update,freeVERTEX);
-    // AVL to determine if duplicate edges and vertices
-    AVL * edgesTree = newAVL(displayEDGE,compareEDGE,freeEDGE);
-    AVL * verticesTree = newAVL(displayVERTEXdebug,compareVERTEX,freeVERTEX);    
-    fpIN1 = fopen(file1,"r");
-    fileString = readFunct(fpIN1);
-    while (!feof(fpIN1)){
-        // Read EACH EDGE DESCRIPTION //
-        while (!(isSemiColon(fileString)) && count < 3){
-            // adding the weight
-            if (count == 2){
-                weight = atoi(fileString);
-            }
-            else{
-                vertices[count] = atoi(fileString);
-            }
-            count++;
-            fileString = readFunct(fpIN1);
-        }
-        // Create VERTEX and EDGE objects ///
-        if (count >= 2){
-            v1 = newVERTEX(vertices[0]);
-            v2 = newVERTEX(vertices[1]);
-            // order the vertices array to check for DUPLICATES
-            if (vertices[0] > vertices[1]){
-                int temp = vertices[0];
-                vertices[0] = vertices[1];
-                vertices[1] = temp;
-            }
-            edge = newEDGE(vertices[0],vertices[1],weight);
-            // Check for loop or Duplicates //
-            if (findAVL(edgesTree,edge) == 0) {
-                insertAVL(edgesTree,edge);
-                VERTEX * foundV1 = 0;
-                VERTEX * foundV2 = 0;
-                foundV1 = findAVL(verticesTree,v1);
-                // new vertex
-                if (foundV1 == 0){
-                    setVERTEXowner(v1,insertBINOMIAL(b,v1));
-                    insertAVL(verticesTree,v1);
-                    foundV1 = v1;
-                    if (toggle != 1){
-                        sourceVertex = v1;
-                        toggle = 1;
-                    }
-                }
-                // doesn't add any more if it is a loop
-                if (vertices[0] != vertices[1]){
-                    foundV2 = findAVL(verticesTree,v2);
-                    if (foundV2 == 0){
-                        setVERTEXowner(v2,insertBINOMIAL(b,v2));
-                        insertAVL(verticesTree,v2);
-                        foundV2 = v2;
-                    }
-                    insertVERTEXneighbor(foundV1,foundV2);
-                    insertVERTEXweight(foundV1,weight);
-                    insertVERTEXneighbor(foundV2,foundV1);
-                    insertVERTEXweight(foundV2,weight);
-                }
-            }
-            else {
-                freeVERTEX(v1);
-                freeVERTEX(v2);
-                freeEDGE(edge);
-            }
-        }
-        // skip this if at least two vertices were not read //
-        else{
-        }
-        // weight is defaulted 1
-        weight = 1;
-        count = 0;
-        fileString = readFunct(fpIN1);
+    CSR * graph = 0;
+    char * file1 = argv[argIndex];
+    if (c == 1){
+        // convert the text graph into a binary graph file and stop
+        if (argIndex + 2 != argc) Fatal("-c needs an input and an output file\n");
+        graph = readGraph(file1);
+        if (writeCSR(graph,argv[argIndex + 1]) == 0) Fatal("could not write %s\n",argv[argIndex + 1]);
+        return 0;
+    }
+    graph = readGraph(file1);
+    if (u != 0){
+        UpdateFunction(graph,u);
+        return 0;
     }
-    fclose(fpIN1);
     
     // display EMPTY if empty graph
-    if (sizeBINOMIAL(b) == 0){
+    if (sizeCSR(graph) == 0){
         printf("EMPTY\n");
         return 0;
     }
+    
+    // Vertex i of the CSR, the first vertex read being the source
+    int * ids = getCSRids(graph);
+    VERTEX ** vertices = malloc(sizeof(VERTEX *) * sizeCSR(graph));
+    assert(vertices != 0);
+    for (int i = 0; i < sizeCSR(graph); i++){
+        vertices[i] = newVERTEX(ids[i]);
+        setVERTEXindex(vertices[i],i);
+    }
+    VERTEX * sourceVertex = vertices[0];
+    // with -f every component gets a tree of its own
+    COMPONENTS * components = (f == 1) ? newCOMPONENTS(graph) : 0;
 
     // NOW RUN PRIM ALGORITHIM ///
     
-    setVERTEXkey(sourceVertex,0);
-    decreaseKeyBINOMIAL(b,getVERTEXowner(sourceVertex),sourceVertex);
-    assert(b != 0);
-    PrimFunct(b,sourceVertex);
-    PrintFunction(sourceVertex);
+    if (strcmp(m,"kruskal") == 0){
+        MSTEDGE * tree = malloc(sizeof(MSTEDGE) * sizeCSR(graph));
+        assert(tree != 0);
+        int count = kruskalMST(graph,tree);
+        orientTree(sizeCSR(graph),vertices,sourceVertex,tree,count);
+        free(tree);
+    }
+    else if (strcmp(m,"filter") == 0){
+        MSTEDGE * tree = malloc(sizeof(MSTEDGE) * sizeCSR(graph));
+        assert(tree != 0);
+        POOL * pool = newPOOL(t);
+        int count = filterKruskalMST(graph,tree,pool);
+        freePOOL(pool);
+        orientTree(sizeCSR(graph),vertices,sourceVertex,tree,count);
+        free(tree);
+    }
+    else if (strcmp(m,"boruvka") == 0){
+        MSTEDGE * tree = malloc(sizeof(MSTEDGE) * sizeCSR(graph));
+        assert(tree != 0);
+        POOL * pool = newPOOL(t);
+        int count = boruvkaMST(graph,tree,pool,(s == 1) ? stderr : 0);
+        freePOOL(pool);
+        orientTree(sizeCSR(graph),vertices,sourceVertex,tree,count);
+        free(tree);
+    }
+    else if (components != 0){
+        PrimForest(components,graph,vertices);
+    }
+    else{
+        PQ * Q = newPQ(q,graph,vertices,s);
+        if (Q == 0){
+            fprintf(stderr,"weights do not fit the %s queue, using the binomial heap\n",q);
+            Q = newPQ("binomial",graph,vertices,s);
+        }
+        assert(Q != 0);
+        PrimFunct(Q,graph,vertices,sourceVertex);
+        if (s == 1) statisticsPQ(Q,stderr);
+        freePQ(Q);
+    }
+    if (components != 0){
+        PrintForest(components,graph,vertices);
+        freeCOMPONENTS(components);
+    }
+    else PrintFunction(graph,vertices,sourceVertex);
     return 0;
 }
 
@@ -315,21 +557,54 @@ Fatal(char *fmt, ...)
     exit(-1);
 }
 
+// the value of an option is either attached, as in -t8, or the next argument
+static char *optionValue(int * argIndex,int argc,char **argv){
+    if (argv[*argIndex][2] != '\0') return argv[*argIndex] + 2;
+    if (*argIndex + 1 >= argc) Fatal("option %s needs a value\n",argv[*argIndex]);
+    *argIndex = *argIndex + 1;
+    return argv[*argIndex];
+}
+
 static int processOptions(int argIndex,int argc, char **argv){
     // looking at the - things
-    while (argIndex < argc && *argv[argIndex] == '-'){
+    // a lone - is standard input, not an option
+    while (argIndex < argc && *argv[argIndex] == '-' && argv[argIndex][1] != '\0'){
         // looks at the first letter after the -
         switch (argv[argIndex][1]){
             case 'v':
                 printf("This program is reads in graphs and runs algorithims with binomial heaps as a priority queue\n");
                 v = 1;
-            case 'r':
-                r = 1;
-                g = 0;
+            case 'c':
+                c = 1;
+                break;
+            case 't':
+                t = atoi(optionValue(&argIndex,argc,argv));
+                if (t < 1) Fatal("option -t needs a positive number of threads\n");
+                break;
+            case 's':
+                s = 1;
                 break;
-            case 'g':
-                r = 0;
-                g = 1;
+            case 'f':
+                f = 1;
+                break;
+            case 'u':
+                u = optionValue(&argIndex,argc,argv);
+                break;
+            case 'm':
+                m = optionValue(&argIndex,argc,argv);
+                if (strcmp(m,"prim") != 0 && strcmp(m,"kruskal") != 0 &&
+                    strcmp(m,"filter") != 0 && strcmp(m,"boruvka") != 0){
+                    Fatal("option -m needs prim, kruskal, filter or boruvka, not %s\n",m);
+                }
+                break;
+            case 'q':
+                q = optionValue(&argIndex,argc,argv);
+                if (!isPQengine(q)){
+                    fprintf(stderr,"priority queues: ");
+                    displayPQengines(stderr);
+                    fprintf(stderr,"\n");
+                    Fatal("option -q does not know %s\n",q);
+                }
                 break;
             default:
                 Fatal("option %s not understood\n",argv[argIndex]);
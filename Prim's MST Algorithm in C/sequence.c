@@ -0,0 +1,267 @@
+/*
+ *  A sequence heap of (key, vertex) entries, after Sanders' "Fast priority
+ *  queues for cached memory", for lazy prim on graphs much larger than
+ *  the cache. Like the LAZY heap it has no decreaseKey: an improved key
+ *  is pushed again and prim skips the stale entries.
+ *
+ *  New entries go into a small insertion heap that stays in the cache.
+ *  When it fills up it is sorted into a run, and runs are kept in levels
+ *  of at most RUNS runs each, level i holding runs of up to
+ *  INSERTION * RUNS^i entries. A full level is merged into one run of
+ *  the next level, so every entry is moved O(log n / log RUNS) times
+ *  and always by sequential scans.
+ *
+ *  The smallest entries of all the runs are merged into a deletion
+ *  buffer a block at a time, so pop only ever looks at the top of the
+ *  insertion heap and the front of the buffer. When the insertion heap
+ *  is flushed the rest of the buffer is merged into the new run, which
+ *  keeps every buffered entry no larger than any entry left in a run.
+ *
+ *  Ties on the key are broken on rank[vertex] as in the LAZY heap. With
+ *  a null rank, ties are broken on the index.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "sequence.h"
+
+#define INSERTION 256   // entries in the insertion heap and deletion buffer
+#define RUNS 4          // runs a level holds before it is merged
+#define MAXLEVELS 24
+
+typedef struct sequenceentry{
+    int key;
+    int vertex;
+}SEQUENCEENTRY;
+
+typedef struct sequencerun{
+    SEQUENCEENTRY * entries;
+    int64_t head;       // the entries before head have been taken
+    int64_t length;
+}SEQUENCERUN;
+
+struct sequence{
+    SEQUENCEENTRY insertion[INSERTION];     // a binary heap
+    int inserted;
+    SEQUENCEENTRY deletion[INSERTION];      // sorted, taken from the front
+    int deletionHead;
+    int deletionLength;
+    SEQUENCERUN runs[MAXLEVELS][RUNS];
+    int counts[MAXLEVELS];
+    int levels;         // levels that have ever held a run
+    int * rank;
+    int64_t size;
+    // statistics
+    long long flushes;
+    long long merges;
+    long long refills;
+};
+
+//Constructor
+extern SEQUENCE *newSEQUENCE(int * rank){
+    SEQUENCE * s = malloc(sizeof(SEQUENCE));
+    assert(s != 0);
+    s->inserted = 0;
+    s->deletionHead = 0;
+    s->deletionLength = 0;
+    for (int l = 0; l < MAXLEVELS; l++){
+        s->counts[l] = 0;
+    }
+    s->levels = 0;
+    s->rank = rank;
+    s->size = 0;
+    s->flushes = 0;
+    s->merges = 0;
+    s->refills = 0;
+    return s;
+}
+
+/// Private helper FUNCTIONS ///
+static int less(SEQUENCE * s,SEQUENCEENTRY a,SEQUENCEENTRY b){
+    if (a.key != b.key) return a.key < b.key;
+    if (s->rank != 0) return s->rank[a.vertex] < s->rank[b.vertex];
+    return a.vertex < b.vertex;
+}
+static SEQUENCEENTRY popInsertion(SEQUENCE * s){
+    SEQUENCEENTRY top = s->insertion[0];
+    s->inserted--;
+    int size = s->inserted;
+    if (size > 0){
+        SEQUENCEENTRY e = s->insertion[size];
+        int slot = 0;
+        while (1){
+            int child = slot * 2 + 1;
+            if (child >= size) break;
+            if (child + 1 < size && less(s,s->insertion[child + 1],s->insertion[child])) child++;
+            if (!less(s,s->insertion[child],e)) break;
+            s->insertion[slot] = s->insertion[child];
+            slot = child;
+        }
+        s->insertion[slot] = e;
+    }
+    return top;
+}
+static int runsLeft(SEQUENCERUN * r){
+    return r->head < r->length;
+}
+// merges the entries left in count runs into one new run
+static SEQUENCERUN mergeRuns(SEQUENCE * s,SEQUENCERUN * runs,int count){
+    SEQUENCERUN merged;
+    merged.length = 0;
+    for (int i = 0; i < count; i++){
+        merged.length += runs[i].length - runs[i].head;
+    }
+    merged.head = 0;
+    merged.entries = malloc(sizeof(SEQUENCEENTRY) * (merged.length + 1));
+    assert(merged.entries != 0);
+    for (int64_t out = 0; out < merged.length; out++){
+        int best = -1;
+        for (int i = 0; i < count; i++){
+            if (!runsLeft(&runs[i])) continue;
+            if (best == -1 || less(s,runs[i].entries[runs[i].head],runs[best].entries[runs[best].head])) best = i;
+        }
+        merged.entries[out] = runs[best].entries[runs[best].head];
+        runs[best].head++;
+    }
+    return merged;
+}
+static void addRun(SEQUENCE * s,SEQUENCERUN run,int level){
+    // a full level is merged into a single run of the next one
+    while (s->counts[level] == RUNS){
+        assert(level + 1 < MAXLEVELS);
+        SEQUENCERUN merged = mergeRuns(s,s->runs[level],RUNS);
+        for (int i = 0; i < RUNS; i++){
+            free(s->runs[level][i].entries);
+        }
+        s->counts[level] = 0;
+        s->merges++;
+        s->runs[level][0] = run;
+        s->counts[level] = 1;
+        run = merged;
+        level++;
+    }
+    s->runs[level][s->counts[level]] = run;
+    s->counts[level]++;
+    if (level + 1 > s->levels) s->levels = level + 1;
+}
+// turns the insertion heap, and whatever is left of the deletion buffer, into a run
+static void flushInsertion(SEQUENCE * s){
+    SEQUENCERUN parts[2];
+    SEQUENCEENTRY sorted[INSERTION];
+    int count = s->inserted;
+    for (int i = 0; i < count; i++){
+        sorted[i] = popInsertion(s);
+    }
+    parts[0].entries = sorted;
+    parts[0].head = 0;
+    parts[0].length = count;
+    parts[1].entries = s->deletion;
+    parts[1].head = s->deletionHead;
+    parts[1].length = s->deletionLength;
+    SEQUENCERUN run = mergeRuns(s,parts,2);
+    s->deletionHead = 0;
+    s->deletionLength = 0;
+    s->flushes++;
+    addRun(s,run,0);
+}
+// moves the smallest entries of all the runs into the deletion buffer
+static void refillDeletion(SEQUENCE * s){
+    SEQUENCERUN * heads[MAXLEVELS * RUNS];
+    int count = 0;
+    for (int l = 0; l < s->levels; l++){
+        for (int i = 0; i < s->counts[l]; i++){
+            heads[count] = &s->runs[l][i];
+            count++;
+        }
+    }
+    s->deletionHead = 0;
+    s->deletionLength = 0;
+    while (s->deletionLength < INSERTION && count > 0){
+        int best = 0;
+        for (int i = 1; i < count; i++){
+            if (less(s,heads[i]->entries[heads[i]->head],heads[best]->entries[heads[best]->head])) best = i;
+        }
+        s->deletion[s->deletionLength] = heads[best]->entries[heads[best]->head];
+        s->deletionLength++;
+        heads[best]->head++;
+        if (!runsLeft(heads[best])){
+            heads[best] = heads[count - 1];
+            count--;
+        }
+    }
+    // runs used up are dropped
+    for (int l = 0; l < s->levels; l++){
+        int kept = 0;
+        for (int i = 0; i < s->counts[l]; i++){
+            if (runsLeft(&s->runs[l][i])) s->runs[l][kept++] = s->runs[l][i];
+            else free(s->runs[l][i].entries);
+        }
+        s->counts[l] = kept;
+    }
+    s->refills++;
+}
+// 1 if the smallest entry is at the front of the deletion buffer
+static int fromDeletion(SEQUENCE * s){
+    if (s->deletionHead == s->deletionLength && s->inserted < s->size) refillDeletion(s);
+    if (s->deletionHead == s->deletionLength) return 0;
+    if (s->inserted == 0) return 1;
+    return less(s,s->deletion[s->deletionHead],s->insertion[0]);
+}
+
+///// PUBLIC FUNCTIONS ////
+extern void pushSEQUENCE(SEQUENCE * s,int vertex,int key){
+    assert(s != 0);
+    if (s->inserted == INSERTION) flushInsertion(s);
+    SEQUENCEENTRY e = {key,vertex};
+    int slot = s->inserted;
+    s->inserted++;
+    while (slot > 0){
+        int parent = (slot - 1) / 2;
+        if (!less(s,e,s->insertion[parent])) break;
+        s->insertion[slot] = s->insertion[parent];
+        slot = parent;
+    }
+    s->insertion[slot] = e;
+    s->size++;
+}
+extern int peekSEQUENCE(SEQUENCE * s){
+    assert(s != 0 && s->size > 0);
+    if (fromDeletion(s)) return s->deletion[s->deletionHead].vertex;
+    return s->insertion[0].vertex;
+}
+// returns the vertex of the smallest entry, and its key through key if not null
+extern int popSEQUENCE(SEQUENCE * s,int * key){
+    assert(s != 0 && s->size > 0);
+    SEQUENCEENTRY e;
+    if (fromDeletion(s)){
+        e = s->deletion[s->deletionHead];
+        s->deletionHead++;
+    }
+    else{
+        e = popInsertion(s);
+    }
+    s->size--;
+    if (key != 0) *key = e.key;
+    return e.vertex;
+}
+extern int64_t sizeSEQUENCE(SEQUENCE * s){
+    if (s == 0) return 0;
+    return s->size;
+}
+extern void statisticsSEQUENCE(SEQUENCE * s,FILE * fp){
+    fprintf(fp,"size: %lld\n",(long long)s->size);
+    fprintf(fp,"levels: %d\n",s->levels);
+    fprintf(fp,"flushes: %lld\n",s->flushes);
+    fprintf(fp,"merges: %lld\n",s->merges);
+    fprintf(fp,"refills: %lld",s->refills);
+}
+extern void freeSEQUENCE(SEQUENCE * s){
+    assert(s != 0);
+    for (int l = 0; l < s->levels; l++){
+        for (int i = 0; i < s->counts[l]; i++){
+            free(s->runs[l][i].entries);
+        }
+    }
+    free((SEQUENCE *)s);
+}
@@ -0,0 +1,17 @@
+#ifndef __SEQUENCE_INCLUDED__
+#define __SEQUENCE_INCLUDED__
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef struct sequence SEQUENCE;
+
+extern SEQUENCE *newSEQUENCE(int *rank);
+extern void pushSEQUENCE(SEQUENCE *s,int vertex,int key);
+extern int peekSEQUENCE(SEQUENCE *s);
+extern int popSEQUENCE(SEQUENCE *s,int *key);
+extern int64_t sizeSEQUENCE(SEQUENCE *s);
+extern void statisticsSEQUENCE(SEQUENCE *s,FILE *fp);
+extern void freeSEQUENCE(SEQUENCE *s);
+
+#endif
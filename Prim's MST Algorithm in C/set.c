@@ -0,0 +1,76 @@
+/*
+ *  A disjoint SET forest over the elements 0..size-1, for kruskal. Find
+ *  halves the path it walks and union hangs the tree of lower rank under
+ *  the other, so a run of operations costs next to nothing per operation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "set.h"
+
+struct set{
+    int * parent;
+    unsigned char * rank;   // ranks stay below 32
+    int size;
+    int count;              // sets left
+};
+
+//Constructor, every element starts in a set of its own
+extern SET *newSET(int size){
+    assert(size >= 0);
+    SET * s = malloc(sizeof(SET));
+    assert(s != 0);
+    s->parent = malloc(sizeof(int) * (size + 1));
+    s->rank = calloc(size + 1,sizeof(unsigned char));
+    assert(s->parent != 0 && s->rank != 0);
+    for (int i = 0; i < size; i++){
+        s->parent[i] = i;
+    }
+    s->size = size;
+    s->count = size;
+    return s;
+}
+
+///// PUBLIC FUNCTIONS ////
+extern int findSET(SET * s,int x){
+    assert(x >= 0 && x < s->size);
+    while (s->parent[x] != x){
+        s->parent[x] = s->parent[s->parent[x]];
+        x = s->parent[x];
+    }
+    return x;
+}
+// walks to the roots without shortening any path, so any number of
+// threads can ask at once as long as nobody is making a union
+extern int sameSET(SET * s,int x,int y){
+    assert(x >= 0 && x < s->size && y >= 0 && y < s->size);
+    while (s->parent[x] != x) x = s->parent[x];
+    while (s->parent[y] != y) y = s->parent[y];
+    return x == y;
+}
+// returns 0 if x and y were already in the same set
+extern int unionSET(SET * s,int x,int y){
+    x = findSET(s,x);
+    y = findSET(s,y);
+    if (x == y) return 0;
+    if (s->rank[x] < s->rank[y]){
+        int temp = x;
+        x = y;
+        y = temp;
+    }
+    s->parent[y] = x;
+    if (s->rank[x] == s->rank[y]) s->rank[x]++;
+    s->count--;
+    return 1;
+}
+extern int countSET(SET * s){
+    assert(s != 0);
+    return s->count;
+}
+extern void freeSET(SET * s){
+    assert(s != 0);
+    free(s->parent);
+    free(s->rank);
+    free((SET *)s);
+}
@@ -0,0 +1,15 @@
+#ifndef __SET_INCLUDED__
+#define __SET_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct set SET;
+
+extern SET *newSET(int size);
+extern int findSET(SET *s,int x);
+extern int sameSET(SET *s,int x,int y);
+extern int unionSET(SET *s,int x,int y);
+extern int countSET(SET *s);
+extern void freeSET(SET *s);
+
+#endif
@@ -0,0 +1,1015 @@
+/*
+ *  The trees of a spanning forest as Euler TOURs cut into blocks, after
+ *  Frederickson's clustering, so that the lightest edge left out of the
+ *  forest that crosses a cut is found without walking either side.
+ *
+ *  The tour of a tree is a cyclic list of items. Every vertex has an item,
+ *  every tree edge an item for each direction, and every edge left out of
+ *  the forest is held by an item at each of its ends. A vertex whose items
+ *  are full gets another, right after its first, so the items of a vertex
+ *  always stand together. The items between the two directions of a tree
+ *  edge (u,v) are the tour of the side of v, the others that of u.
+ *
+ *  The list is cut into blocks of consecutive items, an item weighing one
+ *  plus the edges it holds and a block about the target. Each tree keeps
+ *  a table with, for every pair of its blocks, the lightest edge left out
+ *  between them. The lightest edge across the cut of a tree edge is then
+ *  the lightest entry between a block on one side and a block on the
+ *  other, or an edge held in one of the at most two blocks the cut goes
+ *  through, which are looked at edge by edge. Edges are ordered by weight
+ *  and then by id.
+ *
+ *  With W the weight of everything, the target is about W^(2/3), so a tree
+ *  has O(W^(1/3)) blocks and a table of O(W^(2/3)) entries. Linking or
+ *  cutting splits a few blocks where the tour is cut open, each split
+ *  looking again at the edges of the block and its row of the table, and
+ *  merges them back with their neighbors, so linking, cutting, swapping
+ *  and searching are O(W^(2/3)), W being O(V + E). Holding or dropping an
+ *  edge left out is O(1) amortized unless it was the lightest between its
+ *  blocks. The blocks are cut again to a new target when W has doubled or
+ *  halved, which is O(1) amortized.
+ *
+ *  Vertices are numbered 0..V-1 in the order they are added, each on its
+ *  own to start with. Edge ids are the caller's and may be reused once the
+ *  edge has been cut or deleted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <assert.h>
+#include "tour.h"
+
+// the smallest block target, below it the table is not worth keeping
+#ifndef TOUR_MINIMUM
+#define TOUR_MINIMUM 64
+#endif
+#define NONE LLONG_MAX
+
+// an edge left out as held at one of its ends, with the item at the other
+typedef struct tourheld{
+    long long key;
+    int other;
+}TourHELD;
+
+typedef struct touritem{
+    int vertex;     // -1 for a direction of a tree edge
+    TourHELD * held;
+    int count;
+    int capacity;
+    int block;
+    int position;   // in the block
+}TourITEM;
+
+typedef struct tourblock{
+    int * items;
+    int count;
+    int capacity;
+    int weight;
+    int tree;
+    int index;      // row in the table of the tree
+    int prev;       // in the cyclic tour
+    int next;
+    int side;       // of the last cut searched, when not cut through
+}TourBLOCK;
+
+typedef struct tourtree{
+    int * blocks;       // by row of the table
+    int count;
+    int capacity;
+    long long * table;  // capacity by capacity, the key of the lightest edge between two blocks
+    int live;
+}TourTREE;
+
+typedef struct touredge{
+    int weight;
+    int item[2];    // the items holding the ends of an edge left out, or the two directions of a tree edge
+    int slot[2];
+}TourEDGE;
+
+typedef struct tourvertex{
+    int * items;    // the first is the item of the vertex itself
+    int count;
+    int capacity;
+}TourVERTEX;
+
+struct tour{
+    TourITEM * items;
+    int itemSize;
+    int itemCapacity;
+    int * freeItems;
+    int freeItemCount;
+    TourBLOCK * blocks;
+    int blockSize;
+    int blockCapacity;
+    int * freeBlocks;
+    int freeBlockCount;
+    TourTREE * trees;
+    int treeSize;
+    int treeCapacity;
+    int * freeTrees;
+    int freeTreeCount;
+    TourEDGE * edges;
+    int edgeCapacity;
+    TourVERTEX * vertices;
+    int vertexSize;
+    int vertexCapacity;
+    int * scratch;      // rows of the table, a block capacity each
+    int * others;
+    int * sequence;     // the items of a tour, an item capacity
+    long long weight;   // of all the items
+    long long built;    // the weight the target was chosen for
+    int target;
+    int holds;          // edges an item holds before the vertex gets another
+};
+
+//Constructor
+extern TOUR *newTOUR(void){
+    TOUR * t = malloc(sizeof(TOUR));
+    assert(t != 0);
+    t->itemCapacity = 64;
+    t->blockCapacity = 64;
+    t->treeCapacity = 64;
+    t->edgeCapacity = 64;
+    t->vertexCapacity = 64;
+    t->items = malloc(sizeof(TourITEM) * t->itemCapacity);
+    t->freeItems = malloc(sizeof(int) * t->itemCapacity);
+    t->sequence = malloc(sizeof(int) * t->itemCapacity);
+    t->blocks = malloc(sizeof(TourBLOCK) * t->blockCapacity);
+    t->freeBlocks = malloc(sizeof(int) * t->blockCapacity);
+    t->scratch = malloc(sizeof(int) * t->blockCapacity);
+    t->others = malloc(sizeof(int) * t->blockCapacity);
+    t->trees = malloc(sizeof(TourTREE) * t->treeCapacity);
+    t->freeTrees = malloc(sizeof(int) * t->treeCapacity);
+    t->edges = malloc(sizeof(TourEDGE) * t->edgeCapacity);
+    t->vertices = malloc(sizeof(TourVERTEX) * t->vertexCapacity);
+    assert(t->items != 0 && t->freeItems != 0 && t->sequence != 0);
+    assert(t->blocks != 0 && t->freeBlocks != 0 && t->scratch != 0 && t->others != 0);
+    assert(t->trees != 0 && t->freeTrees != 0 && t->edges != 0 && t->vertices != 0);
+    t->itemSize = 0;
+    t->freeItemCount = 0;
+    t->blockSize = 0;
+    t->freeBlockCount = 0;
+    t->treeSize = 0;
+    t->freeTreeCount = 0;
+    t->vertexSize = 0;
+    t->weight = 0;
+    t->built = 0;
+    t->target = TOUR_MINIMUM;
+    t->holds = (TOUR_MINIMUM < 8) ? 1 : TOUR_MINIMUM / 4;
+    return t;
+}
+
+/// Private helper FUNCTIONS ///
+static long long keyOf(TOUR * t,int id){
+    return (long long)t->edges[id].weight * 4294967296LL + id;
+}
+static int idOf(long long key){
+    return (int)((unsigned long long)key & 0xffffffffULL);
+}
+static int itemWeight(TOUR * t,int x){
+    return 1 + t->items[x].count;
+}
+static int firstItem(TOUR * t,int v){
+    return t->vertices[v].items[0];
+}
+static long long *entry(TOUR * t,int tree,int i,int j){
+    TourTREE * T = &t->trees[tree];
+    return &T->table[(long long)i * T->capacity + j];
+}
+
+//// pools of items, blocks and trees ////
+static int newItem(TOUR * t,int vertex){
+    int x;
+    if (t->freeItemCount > 0) x = t->freeItems[--t->freeItemCount];
+    else{
+        if (t->itemSize == t->itemCapacity){
+            t->itemCapacity *= 2;
+            t->items = realloc(t->items,sizeof(TourITEM) * t->itemCapacity);
+            t->freeItems = realloc(t->freeItems,sizeof(int) * t->itemCapacity);
+            t->sequence = realloc(t->sequence,sizeof(int) * t->itemCapacity);
+            assert(t->items != 0 && t->freeItems != 0 && t->sequence != 0);
+        }
+        x = t->itemSize++;
+    }
+    TourITEM * it = &t->items[x];
+    it->vertex = vertex;
+    it->held = 0;
+    it->count = 0;
+    it->capacity = 0;
+    it->block = -1;
+    it->position = -1;
+    return x;
+}
+static void freeItem(TOUR * t,int x){
+    free(t->items[x].held);
+    t->items[x].held = 0;
+    t->freeItems[t->freeItemCount++] = x;
+}
+static int newBlock(TOUR * t){
+    int b;
+    if (t->freeBlockCount > 0) b = t->freeBlocks[--t->freeBlockCount];
+    else{
+        if (t->blockSize == t->blockCapacity){
+            t->blockCapacity *= 2;
+            t->blocks = realloc(t->blocks,sizeof(TourBLOCK) * t->blockCapacity);
+            t->freeBlocks = realloc(t->freeBlocks,sizeof(int) * t->blockCapacity);
+            t->scratch = realloc(t->scratch,sizeof(int) * t->blockCapacity);
+            t->others = realloc(t->others,sizeof(int) * t->blockCapacity);
+            assert(t->blocks != 0 && t->freeBlocks != 0 && t->scratch != 0 && t->others != 0);
+        }
+        b = t->blockSize++;
+    }
+    TourBLOCK * k = &t->blocks[b];
+    k->items = 0;
+    k->count = 0;
+    k->capacity = 0;
+    k->weight = 0;
+    k->tree = -1;
+    k->index = -1;
+    k->prev = b;
+    k->next = b;
+    k->side = 0;
+    return b;
+}
+static void freeBlock(TOUR * t,int b){
+    free(t->blocks[b].items);
+    t->blocks[b].items = 0;
+    t->freeBlocks[t->freeBlockCount++] = b;
+}
+static int newTree(TOUR * t){
+    int tree;
+    if (t->freeTreeCount > 0) tree = t->freeTrees[--t->freeTreeCount];
+    else{
+        if (t->treeSize == t->treeCapacity){
+            t->treeCapacity *= 2;
+            t->trees = realloc(t->trees,sizeof(TourTREE) * t->treeCapacity);
+            t->freeTrees = realloc(t->freeTrees,sizeof(int) * t->treeCapacity);
+            assert(t->trees != 0 && t->freeTrees != 0);
+        }
+        tree = t->treeSize++;
+    }
+    TourTREE * T = &t->trees[tree];
+    T->capacity = 1;
+    T->count = 0;
+    T->blocks = malloc(sizeof(int));
+    T->table = malloc(sizeof(long long));
+    assert(T->blocks != 0 && T->table != 0);
+    T->live = 1;
+    return tree;
+}
+static void freeTree(TOUR * t,int tree){
+    TourTREE * T = &t->trees[tree];
+    free(T->blocks);
+    free(T->table);
+    T->live = 0;
+    t->freeTrees[t->freeTreeCount++] = tree;
+}
+
+//// the table of a tree ////
+// gives block b the next row of the table, with no edges to any block
+static int addRow(TOUR * t,int tree,int b){
+    TourTREE * T = &t->trees[tree];
+    if (T->count == T->capacity){
+        int capacity = 2 * T->capacity;
+        long long * table = malloc(sizeof(long long) * capacity * capacity);
+        assert(table != 0);
+        for (int i = 0; i < T->count; i++){
+            memcpy(table + (long long)i * capacity,T->table + (long long)i * T->capacity,sizeof(long long) * T->count);
+        }
+        free(T->table);
+        T->table = table;
+        T->capacity = capacity;
+        T->blocks = realloc(T->blocks,sizeof(int) * capacity);
+        assert(T->blocks != 0);
+    }
+    int i = T->count++;
+    T->blocks[i] = b;
+    for (int j = 0; j < T->count; j++){
+        *entry(t,tree,i,j) = NONE;
+        *entry(t,tree,j,i) = NONE;
+    }
+    t->blocks[b].tree = tree;
+    t->blocks[b].index = i;
+    return i;
+}
+// the last row of the table takes the place of the row of block b
+static void removeRow(TOUR * t,int tree,int b){
+    TourTREE * T = &t->trees[tree];
+    int i = t->blocks[b].index;
+    int last = --T->count;
+    if (i == last) return;
+    for (int j = 0; j <= last; j++){
+        *entry(t,tree,i,j) = *entry(t,tree,last,j);
+    }
+    for (int j = 0; j <= last; j++){
+        *entry(t,tree,j,i) = *entry(t,tree,j,last);
+    }
+    T->blocks[i] = T->blocks[last];
+    t->blocks[T->blocks[i]].index = i;
+}
+static void lower(TOUR * t,int tree,int i,int j,long long key){
+    if (i == j) return;
+    long long * a = entry(t,tree,i,j);
+    if (key < *a){
+        *a = key;
+        *entry(t,tree,j,i) = key;
+    }
+}
+// lowers the entries of block b from the edges its items hold, only those
+// to block only when it is not -1
+static void scanBlock(TOUR * t,int b,int only){
+    TourBLOCK * k = &t->blocks[b];
+    TourTREE * T = &t->trees[k->tree];
+    long long * row = T->table + (long long)k->index * T->capacity;
+    for (int i = 0; i < k->count; i++){
+        TourITEM * it = &t->items[k->items[i]];
+        for (int s = 0; s < it->count; s++){
+            int other = t->items[it->held[s].other].block;
+            if (other == b || (only != -1 && other != only)) continue;
+            int j = t->blocks[other].index;
+            if (it->held[s].key < row[j]){
+                row[j] = it->held[s].key;
+                T->table[(long long)j * T->capacity + k->index] = it->held[s].key;
+            }
+        }
+    }
+}
+// finds the rows of blocks b and c again, c being -1 for b alone
+static void fillRows(TOUR * t,int b,int c){
+    int tree = t->blocks[b].tree;
+    int count = t->trees[tree].count;
+    for (int j = 0; j < count; j++){
+        *entry(t,tree,t->blocks[b].index,j) = NONE;
+        *entry(t,tree,j,t->blocks[b].index) = NONE;
+        if (c == -1) continue;
+        *entry(t,tree,t->blocks[c].index,j) = NONE;
+        *entry(t,tree,j,t->blocks[c].index) = NONE;
+    }
+    scanBlock(t,b,-1);
+    if (c != -1) scanBlock(t,c,-1);
+}
+// finds the entry between blocks b and c again from the lighter of them
+static void refreshEntry(TOUR * t,int b,int c){
+    int tree = t->blocks[b].tree;
+    *entry(t,tree,t->blocks[b].index,t->blocks[c].index) = NONE;
+    *entry(t,tree,t->blocks[c].index,t->blocks[b].index) = NONE;
+    if (t->blocks[b].weight <= t->blocks[c].weight) scanBlock(t,b,c);
+    else scanBlock(t,c,b);
+}
+// finds the whole table of a tree again
+static void fillTable(TOUR * t,int tree){
+    TourTREE * T = &t->trees[tree];
+    for (int i = 0; i < T->count; i++){
+        for (int j = 0; j < T->count; j++){
+            *entry(t,tree,i,j) = NONE;
+        }
+    }
+    for (int i = 0; i < T->count; i++){
+        scanBlock(t,T->blocks[i],-1);
+    }
+}
+// gives the rows of tree from onto the end of the table of tree into
+static void moveRows(TOUR * t,int from,int into){
+    int count = t->trees[from].count;
+    for (int i = 0; i < count; i++){
+        t->scratch[i] = addRow(t,into,t->trees[from].blocks[i]);
+    }
+    for (int i = 0; i < count; i++){
+        for (int j = 0; j < count; j++){
+            *entry(t,into,t->scratch[i],t->scratch[j]) = *entry(t,from,i,j);
+        }
+    }
+    freeTree(t,from);
+}
+// moves the blocks of the cyclic list holding block first to a tree of
+// their own, the table of the tree they leave keeping the rest
+static void separate(TOUR * t,int tree,int first){
+    int fresh = newTree(t);
+    int moving = 0;
+    int b = first;
+    do{
+        t->blocks[b].tree = fresh;
+        b = t->blocks[b].next;
+    }while (b != first);
+    int kept = 0;
+    for (int i = 0; i < t->trees[tree].count; i++){
+        if (t->blocks[t->trees[tree].blocks[i]].tree == fresh) t->scratch[moving++] = i;
+        else t->others[kept++] = i;
+    }
+    for (int i = 0; i < moving; i++){
+        addRow(t,fresh,t->trees[tree].blocks[t->scratch[i]]);
+    }
+    for (int i = 0; i < moving; i++){
+        for (int j = 0; j < moving; j++){
+            *entry(t,fresh,i,j) = *entry(t,tree,t->scratch[i],t->scratch[j]);
+        }
+    }
+    // each row kept moves up, never over a row still to be read
+    TourTREE * T = &t->trees[tree];
+    for (int i = 0; i < kept; i++){
+        for (int j = 0; j < kept; j++){
+            *entry(t,tree,i,j) = *entry(t,tree,t->others[i],t->others[j]);
+        }
+        T->blocks[i] = T->blocks[t->others[i]];
+        t->blocks[T->blocks[i]].index = i;
+    }
+    T->count = kept;
+}
+
+//// blocks ////
+static void placeItem(TOUR * t,int b,int position,int x){
+    TourBLOCK * k = &t->blocks[b];
+    if (k->count == k->capacity){
+        k->capacity = (k->capacity == 0) ? 4 : 2 * k->capacity;
+        k->items = realloc(k->items,sizeof(int) * k->capacity);
+        assert(k->items != 0);
+    }
+    for (int i = k->count; i > position; i--){
+        k->items[i] = k->items[i - 1];
+        t->items[k->items[i]].position = i;
+    }
+    k->items[position] = x;
+    k->count++;
+    k->weight += itemWeight(t,x);
+    t->items[x].block = b;
+    t->items[x].position = position;
+}
+// puts count items on the end of block b
+static void appendItems(TOUR * t,int b,int * items,int count){
+    TourBLOCK * k = &t->blocks[b];
+    if (k->count + count > k->capacity){
+        while (k->count + count > k->capacity) k->capacity = (k->capacity == 0) ? 4 : 2 * k->capacity;
+        k->items = realloc(k->items,sizeof(int) * k->capacity);
+        assert(k->items != 0);
+    }
+    for (int i = 0; i < count; i++){
+        TourITEM * it = &t->items[items[i]];
+        it->block = b;
+        it->position = k->count;
+        k->items[k->count++] = items[i];
+        k->weight += 1 + it->count;
+    }
+}
+// takes an item out of its block, and the block out of the tour if that
+// leaves it empty
+static void takeItem(TOUR * t,int x){
+    int b = t->items[x].block;
+    TourBLOCK * k = &t->blocks[b];
+    for (int i = t->items[x].position; i < k->count - 1; i++){
+        k->items[i] = k->items[i + 1];
+        t->items[k->items[i]].position = i;
+    }
+    k->count--;
+    k->weight -= itemWeight(t,x);
+    t->items[x].block = -1;
+    if (k->count > 0) return;
+    t->blocks[k->prev].next = k->next;
+    t->blocks[k->next].prev = k->prev;
+    removeRow(t,k->tree,b);
+    freeBlock(t,b);
+}
+// makes item x the first of a block and returns that block
+static int splitBefore(TOUR * t,int x){
+    int b = t->items[x].block;
+    int position = t->items[x].position;
+    if (position == 0) return b;
+    int c = newBlock(t);
+    addRow(t,t->blocks[b].tree,c);
+    TourBLOCK * k = &t->blocks[b];
+    appendItems(t,c,k->items + position,k->count - position);
+    k->weight -= t->blocks[c].weight;
+    k->count = position;
+    t->blocks[c].prev = b;
+    t->blocks[c].next = k->next;
+    t->blocks[k->next].prev = c;
+    k->next = c;
+    fillRows(t,b,c);
+    return c;
+}
+// moves the items of block c, the one after b, onto the end of b
+static void mergeBlocks(TOUR * t,int b,int c){
+    int tree = t->blocks[b].tree;
+    int i = t->blocks[b].index;
+    int j = t->blocks[c].index;
+    TourTREE * T = &t->trees[tree];
+    long long * row = T->table + (long long)i * T->capacity;
+    long long * merged = T->table + (long long)j * T->capacity;
+    for (int q = 0; q < T->count; q++){
+        if (merged[q] < row[q]){
+            row[q] = merged[q];
+            T->table[(long long)q * T->capacity + i] = merged[q];
+        }
+    }
+    *entry(t,tree,i,j) = NONE;
+    *entry(t,tree,j,i) = NONE;
+    *entry(t,tree,i,i) = NONE;
+    TourBLOCK * k = &t->blocks[c];
+    appendItems(t,b,k->items,k->count);
+    t->blocks[b].next = k->next;
+    t->blocks[k->next].prev = b;
+    removeRow(t,tree,c);
+    freeBlock(t,c);
+}
+// merges the block of item x with its neighbors while two of them together
+// stay within the target, and halves it while it is over twice the target
+static void balance(TOUR * t,int x){
+    int b = t->items[x].block;
+    while (1){
+        TourBLOCK * k = &t->blocks[b];
+        if (k->next != b && k->weight + t->blocks[k->next].weight <= t->target){
+            mergeBlocks(t,b,k->next);
+        }
+        else if (k->prev != b && k->weight + t->blocks[k->prev].weight <= t->target){
+            int p = k->prev;
+            mergeBlocks(t,p,b);
+            b = p;
+        }
+        else break;
+    }
+    while (t->blocks[b].weight > 2 * t->target && t->blocks[b].count > 1){
+        TourBLOCK * k = &t->blocks[b];
+        int half = 0;
+        int position = 0;
+        while (position < k->count - 1 && 2 * half < k->weight){
+            half += itemWeight(t,k->items[position++]);
+        }
+        if (position == 0) position = 1;
+        int c = splitBefore(t,k->items[position]);
+        if (t->items[x].block == c) b = c;
+    }
+}
+// cuts the tours of every tree into blocks of the target weight again
+static void chunkTree(TOUR * t,int tree,int * sequence,int count){
+    t->trees[tree].count = 0;
+    int first = -1;
+    int b = -1;
+    for (int i = 0; i < count; i++){
+        int x = sequence[i];
+        if (b == -1 || t->blocks[b].weight + itemWeight(t,x) > t->target){
+            int c = newBlock(t);
+            addRow(t,tree,c);
+            if (b == -1) first = c;
+            else{
+                t->blocks[b].next = c;
+                t->blocks[c].prev = b;
+            }
+            b = c;
+        }
+        placeItem(t,b,t->blocks[b].count,x);
+    }
+    t->blocks[b].next = first;
+    t->blocks[first].prev = b;
+    fillTable(t,tree);
+}
+static void reblock(TOUR * t){
+    double root = cbrt((double)t->weight);
+    t->built = t->weight;
+    t->target = (int)(root * root / 2);
+    if (t->target < TOUR_MINIMUM) t->target = TOUR_MINIMUM;
+    t->holds = (t->target < 8) ? 1 : t->target / 4;
+    for (int tree = 0; tree < t->treeSize; tree++){
+        if (!t->trees[tree].live) continue;
+        int count = 0;
+        int first = t->trees[tree].blocks[0];
+        int b = first;
+        do{
+            for (int i = 0; i < t->blocks[b].count; i++){
+                t->sequence[count++] = t->blocks[b].items[i];
+            }
+            b = t->blocks[b].next;
+        }while (b != first);
+        for (int i = 0; i < t->trees[tree].count; i++){
+            freeBlock(t,t->trees[tree].blocks[i]);
+        }
+        chunkTree(t,tree,t->sequence,count);
+    }
+}
+// chooses a new target once the weight has doubled or halved
+static void settle(TOUR * t){
+    if (t->weight > 2 * t->built || (t->weight < t->built / 2 && t->built > 2 * TOUR_MINIMUM)) reblock(t);
+}
+
+//// tours ////
+// an item of vertex v with room for another edge
+static int holderOf(TOUR * t,int v){
+    TourVERTEX * vx = &t->vertices[v];
+    int last = vx->items[vx->count - 1];
+    if (t->items[last].count < t->holds) return last;
+    int x = newItem(t,v);
+    vx = &t->vertices[v];
+    if (vx->count == vx->capacity){
+        vx->capacity *= 2;
+        vx->items = realloc(vx->items,sizeof(int) * vx->capacity);
+        assert(vx->items != 0);
+    }
+    vx->items[vx->count++] = x;
+    int first = vx->items[0];
+    placeItem(t,t->items[first].block,t->items[first].position + 1,x);
+    t->weight++;
+    return x;
+}
+static int hold(TOUR * t,int x,long long key,int other){
+    TourITEM * it = &t->items[x];
+    if (it->count == it->capacity){
+        it->capacity = (it->capacity == 0) ? 4 : 2 * it->capacity;
+        it->held = realloc(it->held,sizeof(TourHELD) * it->capacity);
+        assert(it->held != 0);
+    }
+    it->held[it->count].key = key;
+    it->held[it->count].other = other;
+    t->blocks[it->block].weight++;
+    t->weight++;
+    return it->count++;
+}
+static void unhold(TOUR * t,int x,int slot){
+    TourITEM * it = &t->items[x];
+    // the last edge of the item takes the place of the one dropped
+    it->held[slot] = it->held[--it->count];
+    TourEDGE * e = &t->edges[idOf(it->held[slot].key)];
+    if (e->item[0] == x) e->slot[0] = slot;
+    else e->slot[1] = slot;
+    t->blocks[it->block].weight--;
+    t->weight--;
+}
+// takes an empty item that is not the first out of its vertex
+static void dropHolder(TOUR * t,int x){
+    TourVERTEX * vx = &t->vertices[t->items[x].vertex];
+    for (int i = 1; i < vx->count; i++){
+        if (vx->items[i] != x) continue;
+        vx->items[i] = vx->items[--vx->count];
+        break;
+    }
+    takeItem(t,x);
+    freeItem(t,x);
+    t->weight--;
+}
+// the two directions of tree edge id as items
+static void newArcs(TOUR * t,int id){
+    t->edges[id].item[0] = newItem(t,-1);
+    t->edges[id].item[1] = newItem(t,-1);
+}
+// puts the two directions of tree edge id between the cyclic lists of
+// vertices u and v, joining them: the first ends the part before u and the
+// second starts u, with the list of v, from v on, between them
+static void splice(TOUR * t,int id,int u,int v){
+    int bu = splitBefore(t,firstItem(t,u));
+    int bv = splitBefore(t,firstItem(t,v));
+    int a = t->edges[id].item[0];
+    int b = t->edges[id].item[1];
+    int pu = t->blocks[bu].prev;
+    int pv = t->blocks[bv].prev;
+    placeItem(t,pu,t->blocks[pu].count,a);
+    placeItem(t,bu,0,b);
+    t->blocks[pu].next = bv;
+    t->blocks[bv].prev = pu;
+    t->blocks[pv].next = bu;
+    t->blocks[bu].prev = pv;
+    balance(t,a);
+    balance(t,b);
+}
+// takes the two directions of tree edge id out, closing the two cyclic
+// lists they leave, and returns their first blocks through s and r
+static void unsplice(TOUR * t,int id,int * s,int * r){
+    int a = t->edges[id].item[0];
+    int b = t->edges[id].item[1];
+    splitBefore(t,a);
+    int bb = splitBefore(t,b);
+    int ba = t->items[a].block;
+    // s runs from after a to before b, r from after b to before a
+    int sFirst = (t->blocks[ba].count == 1) ? t->blocks[ba].next : ba;
+    int sLast = t->blocks[bb].prev;
+    int rFirst = (t->blocks[bb].count == 1) ? t->blocks[bb].next : bb;
+    int rLast = t->blocks[ba].prev;
+    // the directions hold no edges, so no entry of the table changes
+    takeItem(t,a);
+    takeItem(t,b);
+    t->blocks[sLast].next = sFirst;
+    t->blocks[sFirst].prev = sLast;
+    t->blocks[rLast].next = rFirst;
+    t->blocks[rFirst].prev = rLast;
+    freeItem(t,a);
+    freeItem(t,b);
+    *s = sFirst;
+    *r = rFirst;
+}
+// 1 if item x is between a and b, the two directions of a tree edge, on
+// the tour, 0 if it is between b and a, the sides of blocks not cut
+// through having been marked
+static int sideOf(TOUR * t,int x,int a,int b){
+    int k = t->items[x].block;
+    int ba = t->items[a].block;
+    int bb = t->items[b].block;
+    if (k != ba && k != bb) return t->blocks[k].side;
+    int p = t->items[x].position;
+    int pa = t->items[a].position;
+    int pb = t->items[b].position;
+    if (ba == bb){
+        if (pa < pb) return p > pa && p < pb;
+        return p > pa || p < pb;
+    }
+    if (k == ba) return p > pa;
+    return p < pb;
+}
+static int listLength(TOUR * t,int first){
+    int count = 0;
+    int b = first;
+    do{
+        count++;
+        b = t->blocks[b].next;
+    }while (b != first);
+    return count;
+}
+
+///// PUBLIC FUNCTIONS ////
+// returns the number of the new vertex
+extern int addTOURvertex(TOUR * t){
+    assert(t != 0);
+    if (t->vertexSize == t->vertexCapacity){
+        t->vertexCapacity *= 2;
+        t->vertices = realloc(t->vertices,sizeof(TourVERTEX) * t->vertexCapacity);
+        assert(t->vertices != 0);
+    }
+    int v = t->vertexSize++;
+    int x = newItem(t,v);
+    TourVERTEX * vx = &t->vertices[v];
+    vx->capacity = 1;
+    vx->count = 1;
+    vx->items = malloc(sizeof(int));
+    assert(vx->items != 0);
+    vx->items[0] = x;
+    int b = newBlock(t);
+    addRow(t,newTree(t),b);
+    placeItem(t,b,0,x);
+    t->weight++;
+    settle(t);
+    return v;
+}
+// joins the trees of v1 and v2, which must be different, by tree edge id
+extern void linkTOUR(TOUR * t,int id,int v1,int v2){
+    assert(t != 0 && id >= 0);
+    if (id >= t->edgeCapacity){
+        while (id >= t->edgeCapacity) t->edgeCapacity *= 2;
+        t->edges = realloc(t->edges,sizeof(TourEDGE) * t->edgeCapacity);
+        assert(t->edges != 0);
+    }
+    int tree1 = t->blocks[t->items[firstItem(t,v1)].block].tree;
+    int tree2 = t->blocks[t->items[firstItem(t,v2)].block].tree;
+    assert(tree1 != tree2);
+    // the smaller table is copied into the larger
+    if (t->trees[tree1].count < t->trees[tree2].count) moveRows(t,tree1,tree2);
+    else moveRows(t,tree2,tree1);
+    newArcs(t,id);
+    splice(t,id,v1,v2);
+    t->weight += 2;
+    settle(t);
+}
+// links the trees of a forest at once, its vertices being on their own
+// with no edges held, faster than linking the edges one at a time
+extern void linkTOURforest(TOUR * t,int count,int * ids,int * v1,int * v2){
+    assert(t != 0);
+    int n = t->vertexSize;
+    int * start = calloc(n + 1,sizeof(int));
+    int * adjacent = malloc(sizeof(int) * (2 * count + 1));
+    int * stack = malloc(sizeof(int) * (n + 1));
+    int * cursor = malloc(sizeof(int) * (n + 1));
+    int * parent = malloc(sizeof(int) * (n + 1));
+    char * seen = calloc(n + 1,1);
+    assert(start != 0 && adjacent != 0 && stack != 0 && cursor != 0 && parent != 0 && seen != 0);
+    for (int e = 0; e < count; e++){
+        int id = ids[e];
+        while (id >= t->edgeCapacity){
+            t->edgeCapacity *= 2;
+            t->edges = realloc(t->edges,sizeof(TourEDGE) * t->edgeCapacity);
+            assert(t->edges != 0);
+        }
+        newArcs(t,id);
+        start[v1[e] + 1]++;
+        start[v2[e] + 1]++;
+    }
+    for (int v = 0; v < n; v++){
+        start[v + 1] += start[v];
+    }
+    for (int v = 0; v <= n; v++){
+        cursor[v] = start[v];
+    }
+    for (int e = 0; e < count; e++){
+        adjacent[cursor[v1[e]]++] = e;
+        adjacent[cursor[v2[e]]++] = e;
+    }
+    for (int root = 0; root < n; root++){
+        if (seen[root] || start[root] == start[root + 1]) continue;
+        // depth first, each edge going in from one side and out from the other
+        int length = 0;
+        int depth = 0;
+        stack[depth] = root;
+        cursor[root] = start[root];
+        parent[root] = -1;
+        seen[root] = 1;
+        t->sequence[length++] = firstItem(t,root);
+        while (depth >= 0){
+            int u = stack[depth];
+            if (cursor[u] == start[u + 1]){
+                if (parent[u] != -1){
+                    int e = parent[u];
+                    t->sequence[length++] = t->edges[ids[e]].item[(v1[e] == u) ? 0 : 1];
+                }
+                depth--;
+                continue;
+            }
+            int e = adjacent[cursor[u]++];
+            int w = (v1[e] == u) ? v2[e] : v1[e];
+            if (seen[w]) continue;
+            seen[w] = 1;
+            t->sequence[length++] = t->edges[ids[e]].item[(v1[e] == u) ? 0 : 1];
+            t->sequence[length++] = firstItem(t,w);
+            parent[w] = e;
+            cursor[w] = start[w];
+            stack[++depth] = w;
+        }
+        // every vertex gives up its block and tree but the root its tree
+        int tree = t->blocks[t->items[firstItem(t,root)].block].tree;
+        for (int i = 0; i < length; i++){
+            int x = t->sequence[i];
+            if (t->items[x].block == -1) continue;
+            int b = t->items[x].block;
+            assert(t->blocks[b].count == 1);
+            if (t->blocks[b].tree != tree) freeTree(t,t->blocks[b].tree);
+            freeBlock(t,b);
+        }
+        chunkTree(t,tree,t->sequence,length);
+    }
+    free(start);
+    free(adjacent);
+    free(stack);
+    free(cursor);
+    free(parent);
+    free(seen);
+    t->weight += 2 * count;
+    settle(t);
+}
+// cuts tree edge id, when no edge held crosses the cut
+extern void cutTOUR(TOUR * t,int id){
+    assert(t != 0);
+    int tree = t->blocks[t->items[t->edges[id].item[0]].block].tree;
+    int s;
+    int r;
+    unsplice(t,id,&s,&r);
+    int hs = t->blocks[s].items[0];
+    int hr = t->blocks[r].items[0];
+    if (listLength(t,s) <= listLength(t,r)) separate(t,tree,s);
+    else separate(t,tree,r);
+    balance(t,hs);
+    balance(t,hr);
+    t->weight -= 2;
+    settle(t);
+}
+// puts edge in, no longer held, in the place of tree edge out, v1 and v2
+// being the ends of in on the two sides of out
+extern void swapTOUR(TOUR * t,int out,int in,int v1,int v2){
+    assert(t != 0);
+    int s;
+    int r;
+    unsplice(t,out,&s,&r);
+    int hs = t->blocks[s].items[0];
+    int hr = t->blocks[r].items[0];
+    if (in >= t->edgeCapacity){
+        while (in >= t->edgeCapacity) t->edgeCapacity *= 2;
+        t->edges = realloc(t->edges,sizeof(TourEDGE) * t->edgeCapacity);
+        assert(t->edges != 0);
+    }
+    newArcs(t,in);
+    splice(t,in,v1,v2);
+    balance(t,hs);
+    balance(t,hr);
+}
+// the lightest edge held that crosses the cut of tree edge id, -1 if none
+extern int crossingTOUR(TOUR * t,int id){
+    assert(t != 0);
+    int a = t->edges[id].item[0];
+    int b = t->edges[id].item[1];
+    int ba = t->items[a].block;
+    int bb = t->items[b].block;
+    int tree = t->blocks[ba].tree;
+    int sides = 0;
+    int others = 0;
+    if (ba == bb){
+        // one side lies within the block, the other wraps around the tour
+        int wrapped = t->items[b].position < t->items[a].position;
+        for (int k = t->blocks[ba].next; k != ba; k = t->blocks[k].next){
+            t->blocks[k].side = wrapped;
+            if (wrapped) t->scratch[sides++] = t->blocks[k].index;
+            else t->others[others++] = t->blocks[k].index;
+        }
+    }
+    else{
+        for (int k = t->blocks[ba].next; k != bb; k = t->blocks[k].next){
+            t->blocks[k].side = 1;
+            t->scratch[sides++] = t->blocks[k].index;
+        }
+        for (int k = t->blocks[bb].next; k != ba; k = t->blocks[k].next){
+            t->blocks[k].side = 0;
+            t->others[others++] = t->blocks[k].index;
+        }
+    }
+    long long best = NONE;
+    for (int i = 0; i < sides; i++){
+        long long * row = entry(t,tree,t->scratch[i],0);
+        for (int j = 0; j < others; j++){
+            if (row[t->others[j]] < best) best = row[t->others[j]];
+        }
+    }
+    // the two blocks cut through are looked at edge by edge
+    for (int k = 0; k < 2; k++){
+        int c = (k == 0) ? ba : bb;
+        if (k == 1 && bb == ba) break;
+        TourBLOCK * block = &t->blocks[c];
+        for (int i = 0; i < block->count; i++){
+            int x = block->items[i];
+            TourITEM * it = &t->items[x];
+            if (it->count == 0) continue;
+            int side = sideOf(t,x,a,b);
+            for (int q = 0; q < it->count; q++){
+                if (it->held[q].key < best && sideOf(t,it->held[q].other,a,b) != side) best = it->held[q].key;
+            }
+        }
+    }
+    return (best == NONE) ? -1 : idOf(best);
+}
+// holds edge id between v1 and v2, which must be in the same tree
+extern void insertTOURedge(TOUR * t,int id,int v1,int v2,int weight){
+    assert(t != 0 && id >= 0 && v1 != v2);
+    if (id >= t->edgeCapacity){
+        while (id >= t->edgeCapacity) t->edgeCapacity *= 2;
+        t->edges = realloc(t->edges,sizeof(TourEDGE) * t->edgeCapacity);
+        assert(t->edges != 0);
+    }
+    t->edges[id].weight = weight;
+    long long key = keyOf(t,id);
+    int x1 = holderOf(t,v1);
+    int x2 = holderOf(t,v2);
+    t->edges[id].item[0] = x1;
+    t->edges[id].slot[0] = hold(t,x1,key,x2);
+    t->edges[id].item[1] = x2;
+    t->edges[id].slot[1] = hold(t,x2,key,x1);
+    int b1 = t->items[x1].block;
+    int b2 = t->items[x2].block;
+    assert(t->blocks[b1].tree == t->blocks[b2].tree);
+    lower(t,t->blocks[b1].tree,t->blocks[b1].index,t->blocks[b2].index,key);
+    balance(t,x1);
+    balance(t,x2);
+    settle(t);
+}
+extern void deleteTOURedge(TOUR * t,int id){
+    assert(t != 0);
+    TourEDGE * e = &t->edges[id];
+    int b1 = t->items[e->item[0]].block;
+    int b2 = t->items[e->item[1]].block;
+    int tree = t->blocks[b1].tree;
+    int stale = b1 != b2 && *entry(t,tree,t->blocks[b1].index,t->blocks[b2].index) == keyOf(t,id);
+    unhold(t,e->item[0],e->slot[0]);
+    unhold(t,e->item[1],e->slot[1]);
+    if (stale) refreshEntry(t,b1,b2);
+    for (int k = 0; k < 2; k++){
+        int x = e->item[k];
+        int v = t->items[x].vertex;
+        if (t->items[x].count == 0 && x != firstItem(t,v)){
+            dropHolder(t,x);
+            x = firstItem(t,v);
+        }
+        balance(t,x);
+    }
+    settle(t);
+}
+extern void freeTOUR(TOUR * t){
+    assert(t != 0);
+    // items and blocks that were freed have nothing left to free
+    for (int x = 0; x < t->itemSize; x++){
+        free(t->items[x].held);
+    }
+    for (int b = 0; b < t->blockSize; b++){
+        free(t->blocks[b].items);
+    }
+    for (int tree = 0; tree < t->treeSize; tree++){
+        if (!t->trees[tree].live) continue;
+        free(t->trees[tree].blocks);
+        free(t->trees[tree].table);
+    }
+    for (int v = 0; v < t->vertexSize; v++){
+        free(t->vertices[v].items);
+    }
+    free(t->items);
+    free(t->freeItems);
+    free(t->sequence);
+    free(t->blocks);
+    free(t->freeBlocks);
+    free(t->scratch);
+    free(t->others);
+    free(t->trees);
+    free(t->freeTrees);
+    free(t->edges);
+    free(t->vertices);
+    free((TOUR *)t);
+}
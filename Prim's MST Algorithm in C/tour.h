@@ -0,0 +1,19 @@
+#ifndef __TOUR_INCLUDED__
+#define __TOUR_INCLUDED__
+
+#include <stdio.h>
+
+typedef struct tour TOUR;
+
+extern TOUR *newTOUR(void);
+extern int addTOURvertex(TOUR *t);
+extern void linkTOUR(TOUR *t,int id,int v1,int v2);
+extern void linkTOURforest(TOUR *t,int count,int *ids,int *v1,int *v2);
+extern void cutTOUR(TOUR *t,int id);
+extern void swapTOUR(TOUR *t,int out,int in,int v1,int v2);
+extern int crossingTOUR(TOUR *t,int id);
+extern void insertTOURedge(TOUR *t,int id,int v1,int v2,int weight);
+extern void deleteTOURedge(TOUR *t,int id);
+extern void freeTOUR(TOUR *t);
+
+#endif
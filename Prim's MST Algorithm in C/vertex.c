@@ -27,6 +27,7 @@ struct vertex
     DLL *successors;                //reserved for graph algorithms
     VERTEX *pred;                   //reserved for graph algorithms
     void *owner;                    //reserved for graph algorithms
+    int index;                      //reserved for graph algorithms
     };
 
 /***** public methods *******************************************************/
@@ -44,9 +45,11 @@ newVERTEX(int n)
     v->flag = 0;
     v->pred = 0;
     v->owner = 0;
-    v->neighbors = newDLL(displayVERTEX,0);
-    v->weights = newDLL(displayINTEGER,freeINTEGER);
-    v->successors = newDLL(displayVERTEX,0);
+    v->index = -1;
+    // the lists are only made when first used, prim keeps the graph in a CSR
+    v->neighbors = 0;
+    v->weights = 0;
+    v->successors = 0;
     return v;
     }
 
@@ -54,8 +57,9 @@ void
 freeVERTEX(void *w)
     {
     VERTEX *v = w;
-    freeDLL(v->neighbors);
-    freeDLL(v->weights);
+    if (v->neighbors) freeDLL(v->neighbors);
+    if (v->weights) freeDLL(v->weights);
+    if (v->successors) freeDLL(v->successors);
     free(v);
     }
 
@@ -64,11 +68,30 @@ freeVERTEX(void *w)
 int getVERTEXnumber(VERTEX *v) { return v->number; }
 int getVERTEXflag(VERTEX *v) { return v->flag; }
 void *getVERTEXowner(VERTEX *v) { return v->owner; }
+int getVERTEXindex(VERTEX *v) { return v->index; }
 VERTEX *getVERTEXpred(VERTEX *v) { return v->pred; }
 int getVERTEXkey(VERTEX *v) { return v->key; }
-DLL *getVERTEXneighbors(VERTEX *v) { return v->neighbors; }
-DLL *getVERTEXweights(VERTEX *v) { return v->weights; }
-DLL *getVERTEXsuccessors(VERTEX *v) { return v->successors; }
+
+DLL *
+getVERTEXneighbors(VERTEX *v)
+    {
+    if (v->neighbors == 0) v->neighbors = newDLL(displayVERTEX,0);
+    return v->neighbors;
+    }
+
+DLL *
+getVERTEXweights(VERTEX *v)
+    {
+    if (v->weights == 0) v->weights = newDLL(displayINTEGER,freeINTEGER);
+    return v->weights;
+    }
+
+DLL *
+getVERTEXsuccessors(VERTEX *v)
+    {
+    if (v->successors == 0) v->successors = newDLL(displayVERTEX,0);
+    return v->successors;
+    }
 
 /*** mutators ********************/
 
@@ -80,6 +103,14 @@ setVERTEXowner(VERTEX *v,void *o)
     return temp;
     }
 
+int
+setVERTEXindex(VERTEX *v,int i)
+    {
+    int temp = v->index;
+    v->index = i;
+    return temp;
+    }
+
 int
 setVERTEXflag(VERTEX *v,int f)
     {
@@ -107,19 +138,22 @@ setVERTEXkey(VERTEX *v,int k)
 void
 insertVERTEXneighbor(VERTEX *v,VERTEX *w)
     {
-    insertDLL(v->neighbors,sizeDLL(v->neighbors),w);
+    DLL *neighbors = getVERTEXneighbors(v);
+    insertDLL(neighbors,sizeDLL(neighbors),w);
     }
 
 void
 insertVERTEXweight(VERTEX *v,int i)
     {
-    insertDLL(v->weights,sizeDLL(v->weights),newINTEGER(i));
+    DLL *weights = getVERTEXweights(v);
+    insertDLL(weights,sizeDLL(weights),newINTEGER(i));
     }
 
 void
 insertVERTEXsuccessor(VERTEX *v,VERTEX *w)
     {
-    insertDLL(v->successors,sizeDLL(v->successors),w);
+    DLL *successors = getVERTEXsuccessors(v);
+    insertDLL(successors,sizeDLL(successors),w);
     }
 
 /*** informational ***************/
@@ -137,11 +171,10 @@ compareVERTEX(void *a,void *b)
     else if (x->key != -1 && y->key == -1)
         return -1;
 
-    int r = x->key - y->key;
-    if (r == 0)
-        return x->number - y->number;
-    else
-        return r;
+    // compared rather than subtracted, so huge numbers cannot overflow
+    if (x->key != y->key)
+        return (x->key > y->key) ? 1 : -1;
+    return (x->number > y->number) - (x->number < y->number);
     }
 
 /*** visualizers *****************/
@@ -158,7 +191,7 @@ displayVERTEXdebug(void *v,FILE *fp)
     {
     VERTEX *a = v;
     fprintf(fp,"%d:",a->number);
-    displayDLL(a->neighbors,fp);
-    displayDLL(a->weights,fp);
-    displayDLL(a->successors,fp);
+    displayDLL(getVERTEXneighbors(a),fp);
+    displayDLL(getVERTEXweights(a),fp);
+    displayDLL(getVERTEXsuccessors(a),fp);
     }
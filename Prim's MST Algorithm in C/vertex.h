@@ -12,6 +12,8 @@ extern VERTEX *newVERTEX(int);
 extern int getVERTEXnumber(VERTEX *);
 extern void *getVERTEXowner(VERTEX *);
 extern void *setVERTEXowner(VERTEX *,void *);
+extern int getVERTEXindex(VERTEX *);
+extern int setVERTEXindex(VERTEX *,int);
 extern int getVERTEXflag(VERTEX *);
 extern int setVERTEXflag(VERTEX *,int);
 extern VERTEX *getVERTEXpred(VERTEX *);